@@ -0,0 +1,118 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+#include "AWEngine/Packet/PacketClient.hpp"
+#include "AWEngine/Packet/Protocol.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#include "Check.hpp"
+
+// Heap allocations made by `PacketServer::Update` per received packet, with heap and arena parser.
+// Only allocations of the thread calling `Update` are counted, network threads are not.
+
+static thread_local bool t_Counting    = false;
+static thread_local std::size_t t_Allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    if(t_Counting)
+        t_Allocations++;
+    if(void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+using namespace AWEngine::Packet;
+
+struct Move : public IPacket<PacketID>
+{
+    static const constexpr PacketID s_ID = PacketID::Move;
+
+    explicit Move(float x, float y) : IPacket<PacketID>(s_ID), X(x), Y(y) {}
+    explicit Move(PacketBuffer& in) : IPacket<PacketID>(s_ID) { in >> X >> Y; }
+
+    float X;
+    float Y;
+
+    void Write(PacketBuffer& out) const override { out << X << Y; }
+};
+
+struct Chat : public IPacket<PacketID>
+{
+    static const constexpr PacketID s_ID = PacketID::Chat;
+
+    explicit Chat(std::string text) : IPacket<PacketID>(s_ID), Text(std::move(text)) {}
+    explicit Chat(PacketBuffer& in) : IPacket<PacketID>(s_ID) { in >> Text; }
+
+    std::string Text;
+
+    void Write(PacketBuffer& out) const override { out << Text; }
+};
+
+typedef Protocol<PacketID, Move, Chat>   Protocol_t;
+typedef PacketServer<PacketID, PacketID> PacketServer_t;
+typedef PacketClient<PacketID, PacketID> PacketClient_t;
+
+static const std::size_t Rounds          = 20;
+static const std::size_t WarmupRounds    = 2;
+static const std::size_t PacketsPerRound = 1000;
+
+template<typename TParser>
+void Run(const char* name, TParser parser, uint16_t port)
+{
+    PacketServerConfiguration serverConfig;
+    serverConfig.Port = port;
+
+    PacketServer_t server(serverConfig, parser, "AWE_BNCH", 0);
+    std::size_t packets = 0;
+    server.OnPacket      = [&](const PacketServer_t::Connection_ptr&, PacketServer_t::Packet_ptr&) { packets++; };
+    server.OnArenaPacket = [&](const PacketServer_t::Connection_ptr&, IPacket<PacketID>&) { packets++; };
+    server.Start();
+
+    PacketClient_t client("AWE_BNCH", 0);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+
+    std::size_t                       allocations = 0;
+    std::chrono::steady_clock::duration time       = {};
+    for(std::size_t round = 0; round < Rounds; round++)
+    {
+        for(std::size_t i = 0; i < PacketsPerRound; i++)
+        {
+            if(i % 2 == 0)
+                client.Send(Move(float(i), -float(i)));
+            else
+                client.Send(Chat("Hello"));
+        }
+
+        std::size_t expected = (round + 1) * PacketsPerRound;
+        while(packets < expected)
+        {
+            t_Allocations = 0;
+            auto start = std::chrono::steady_clock::now();
+            t_Counting = true;
+            server.Update(-1, false);
+            t_Counting = false;
+            if(round >= WarmupRounds)
+            {
+                time        += std::chrono::steady_clock::now() - start;
+                allocations += t_Allocations;
+            }
+        }
+    }
+
+    std::size_t measured = (Rounds - WarmupRounds) * PacketsPerRound;
+    std::cout
+        << name
+        << " allocations/packet=" << double(allocations) / double(measured)
+        << " ns/packet=" << std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / measured
+        << std::endl;
+}
+
+int main()
+{
+    Run("heap ", PacketServer_t::PacketParser_t(&Protocol_t::Parse), 10151);
+    Run("arena", PacketServer_t::ArenaPacketParser_t(&Protocol_t::ParseInto), 10152);
+}
@@ -0,0 +1,102 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include "Check.hpp"
+
+// Throughput of small packets received by the server over loopback, reading every header and body directly
+// and through receive buffers.
+// Clients write pre-serialized packets in big chunks so the server is the bottleneck.
+
+using namespace AWEngine::Packet;
+
+struct Move
+{
+    static const constexpr PacketID s_ID      = PacketID::Move;
+    static const constexpr uint32_t s_MaxSize = sizeof(uint32_t) + 2 * sizeof(float);
+
+    uint32_t Entity;
+    float    X;
+    float    Y;
+
+    void Write(PacketBuffer& out) const { out << Entity << X << Y; }
+};
+
+typedef PacketServer<PacketID, PacketID>                           PacketServer_t;
+typedef Util::Connection<PacketID, PacketID::Ping, PacketID::Init> Connection_t;
+
+static const std::size_t ClientCount      = 4;
+static const std::size_t PacketsPerClient = 250'000;
+static const std::size_t PacketsPerWrite  = 1'000;
+
+void Run(std::size_t receiveBuffers, uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port           = port;
+    config.MaxPlayers     = ClientCount;
+    config.ReceiveBuffers = receiveBuffers;
+    config.IdleTimeout    = std::chrono::milliseconds(0);
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_BNCH", 0);
+
+    std::size_t received = 0;
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr&, Util::PacketSendInfo& info)
+    {
+        if(info.Header.ID == static_cast<uint8_t>(PacketID::Move))
+            received++;
+    };
+    server.Start();
+
+    // Chunk of packets written by a single call
+    Connection_t::Frame_ptr frame = Connection_t::MakeFrame(Move{ 1, 2.0f, 3.0f });
+    const uint8_t* frameData = static_cast<const uint8_t*>(frame->Body.Frame().data());
+    std::vector<uint8_t> chunk;
+    for(std::size_t i = 0; i < PacketsPerWrite; i++)
+        chunk.insert(chunk.end(), frameData, frameData + frame->Body.Frame().size());
+    Connection_t::Frame_ptr init = Connection_t::MakeFrame(ToServer::Login::Init<PacketID, PacketID::Init>("AWE_BNCH", 0, Util::LocaleInfo(), ToServer::Login::NextInitStep::Join));
+
+    asio::io_context clientContext;
+    std::vector<asio::ip::tcp::socket> sockets;
+    for(std::size_t i = 0; i < ClientCount; i++)
+    {
+        sockets.emplace_back(clientContext);
+        sockets.back().connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+        asio::write(sockets.back(), init->Body.Frame());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> writers;
+    for(asio::ip::tcp::socket& socket : sockets)
+    {
+        writers.emplace_back(
+            [&socket, &chunk]()
+            {
+                for(std::size_t i = 0; i < PacketsPerClient / PacketsPerWrite; i++)
+                    asio::write(socket, asio::buffer(chunk));
+            }
+        );
+    }
+
+    while(received < ClientCount * PacketsPerClient)
+        if(server.Update(-1, false) == 0)
+            server.WaitFor(std::chrono::milliseconds(10));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    for(std::thread& writer : writers)
+        writer.join();
+    server.Stop();
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double packets = static_cast<double>(ClientCount * PacketsPerClient);
+    std::cout
+        << (receiveBuffers != 0 ? "receive buffers" : "direct reads   ")
+        << " packets/s=" << static_cast<uint64_t>(packets / seconds)
+        << " MB/s=" << static_cast<uint64_t>(packets * frame->Body.Frame().size() / seconds / 1'000'000)
+        << std::endl;
+}
+
+int main()
+{
+    Run(0, 10113);
+    Run(ClientCount, 10114);
+}
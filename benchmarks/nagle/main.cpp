@@ -0,0 +1,97 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+#include "AWEngine/Packet/PacketClient.hpp"
+
+#include <atomic>
+#include <algorithm>
+#include <vector>
+
+#include "Check.hpp"
+
+// Round-trip time of a small packet with and without Nagle's algorithm.
+// Packet header and body are written to the socket separately so with Nagle enabled the body waits for ACK of the header.
+
+using namespace AWEngine::Packet;
+
+struct Echo : public IPacket<PacketID>
+{
+    explicit Echo(uint32_t value) : IPacket<PacketID>(PacketID::Echo), Value(value) {}
+    explicit Echo(PacketBuffer& in) : IPacket<PacketID>(PacketID::Echo) { in >> Value; }
+
+    uint32_t Value;
+
+    void Write(PacketBuffer& out) const override { out << Value; }
+};
+
+typedef PacketServer<PacketID, PacketID> PacketServer_t;
+typedef PacketClient<PacketID, PacketID> PacketClient_t;
+
+static const std::size_t Iterations = 100;
+
+void Run(bool noDelay, uint16_t port)
+{
+    PacketServerConfiguration serverConfig;
+    serverConfig.Port = port;
+    serverConfig.Socket.NoDelay = noDelay;
+
+    PacketServer_t server(
+        serverConfig,
+        [](Util::PacketSendInfo& info) -> PacketServer_t::Packet_Receive_ptr
+        {
+            if(info.Header.ID == static_cast<uint8_t>(PacketID::Echo))
+                return std::make_unique<Echo>(info.Body);
+            return {};
+        },
+        "AWE_BNCH",
+        0
+    );
+    server.OnPacket = [](const PacketServer_t::Connection_ptr& client, PacketServer_t::Packet_ptr& packet)
+    {
+        client->Send(*packet);
+    };
+    server.Start();
+
+    std::atomic_bool running = true;
+    std::thread serverThread([&]()
+    {
+        while(running)
+            if(server.Update(-1, false) == 0)
+                std::this_thread::yield();
+    });
+
+    Util::SocketOptions clientOptions;
+    clientOptions.NoDelay = noDelay;
+
+    PacketClient_t client("AWE_BNCH", 0, clientOptions);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+
+    std::vector<std::chrono::steady_clock::duration> samples;
+    samples.reserve(Iterations);
+    for(uint32_t i = 0; i < Iterations; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        client.Send(Echo(i));
+        while(!client.HasIncoming())
+            std::this_thread::yield();
+        samples.emplace_back(std::chrono::steady_clock::now() - start);
+        client.Incoming().pop_front();
+    }
+
+    running = false;
+    serverThread.join();
+
+    std::sort(samples.begin(), samples.end());
+    auto us = [](std::chrono::steady_clock::duration d) { return std::chrono::duration_cast<std::chrono::microseconds>(d).count(); };
+    std::cout
+        << "TCP_NODELAY=" << (noDelay ? "on " : "off")
+        << " p50=" << us(samples[samples.size() / 2]) << "us"
+        << " p99=" << us(samples[samples.size() * 99 / 100]) << "us"
+        << " max=" << us(samples.back()) << "us"
+        << std::endl;
+}
+
+int main()
+{
+    Run(false, 10111);
+    Run(true, 10112);
+}
@@ -0,0 +1,96 @@
+#include "AWEngine/Packet/Util/Connection.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#include "Check.hpp"
+
+// Cost of serializing a small packet into a frame through virtual `IPacket::Write`
+// and through templated `MakeFrame` of a packet type known at compile time.
+
+static std::size_t s_Allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    s_Allocations++;
+    if(void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+using namespace AWEngine::Packet;
+
+typedef Util::Connection<PacketID, PacketID::Ping, PacketID::Init> Connection_t;
+
+/// Dynamic packet, sent through `IPacket&`
+struct MoveDynamic : public IPacket<PacketID>
+{
+    explicit MoveDynamic(uint32_t entity, float x, float y) : IPacket<PacketID>(PacketID::Move), Entity(entity), X(x), Y(y) {}
+
+    uint32_t Entity;
+    float    X;
+    float    Y;
+
+    void Write(PacketBuffer& out) const override { out << Entity << X << Y; }
+};
+
+/// Same packet with compile-time ID and size, no vtable
+struct Move
+{
+    static const constexpr PacketID s_ID      = PacketID::Move;
+    static const constexpr uint32_t s_MaxSize = sizeof(uint32_t) + 2 * sizeof(float);
+
+    uint32_t Entity;
+    float    X;
+    float    Y;
+
+    void Write(PacketBuffer& out) const { out << Entity << X << Y; }
+};
+static_assert(StaticPacketConcept<Move, PacketID>);
+
+static const std::size_t Rounds          = 20;
+static const std::size_t WarmupRounds    = 2;
+static const std::size_t PacketsPerRound = 100000;
+
+template<typename TMake>
+void Run(const char* name, TMake make)
+{
+    std::size_t                         allocations = 0;
+    std::chrono::steady_clock::duration time        = {};
+    std::size_t                         bytes       = 0;
+    for(std::size_t round = 0; round < Rounds; round++)
+    {
+        std::size_t allocationsBefore = s_Allocations;
+        auto start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < PacketsPerRound; i++)
+        {
+            Connection_t::Frame_ptr frame = make(i);
+            bytes += frame->Body.size();
+        }
+        if(round >= WarmupRounds)
+        {
+            time        += std::chrono::steady_clock::now() - start;
+            allocations += s_Allocations - allocationsBefore;
+        }
+    }
+
+    std::size_t measured = (Rounds - WarmupRounds) * PacketsPerRound;
+    std::cout
+        << name
+        << " allocations/packet=" << double(allocations) / double(measured)
+        << " ns/packet=" << double(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count()) / double(measured)
+        << " (" << bytes << " B)"
+        << std::endl;
+}
+
+int main()
+{
+    // Held through base pointer so the compiler cannot devirtualize the call
+    std::unique_ptr<IPacket<PacketID>> dynamic = std::make_unique<MoveDynamic>(7, 1.5f, -2.0f);
+    Run("virtual", [&](std::size_t) { return Connection_t::MakeFrame(*dynamic); });
+
+    Move move = { 7, 1.5f, -2.0f };
+    Run("static ", [&](std::size_t) { return Connection_t::MakeFrame(move); });
+}
@@ -0,0 +1,153 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+
+#include <vector>
+
+#if defined(__linux__)
+#   include <sys/resource.h>
+#   include <sys/wait.h>
+#   include <unistd.h>
+#endif
+
+#include "Check.hpp"
+
+// CPU time the server spends broadcasting big frames (e.g. world chunks) with copying sends and with MSG_ZEROCOPY.
+// Clients run in a forked process so only the server is measured.
+// Over loopback the kernel copies zero-copy data on delivery anyway (reported as `copied`),
+// measure between two machines to see the real saving.
+
+using namespace AWEngine::Packet;
+
+struct Chunk
+{
+    static const constexpr PacketID s_ID      = PacketID::Chunk;
+    static const constexpr uint32_t s_MaxSize = PacketBuffer::MaxSize;
+
+    void Write(PacketBuffer& out) const
+    {
+        for(std::size_t i = 0; i < s_MaxSize / sizeof(uint32_t); i++)
+            out << static_cast<uint32_t>(i);
+    }
+};
+
+typedef PacketServer<PacketID, PacketID>                           PacketServer_t;
+typedef Util::Connection<PacketID, PacketID::Ping, PacketID::Init> Connection_t;
+
+static const std::size_t ClientCount = 8;
+static const std::size_t ChunkCount  = 2'000;
+
+#if defined(__linux__)
+/// User + system time of the whole process
+std::chrono::duration<double> ProcessCpuTime()
+{
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + std::chrono::microseconds(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+/// Connect all clients and read until the server closes the connections
+[[noreturn]] void RunClients(uint16_t port)
+{
+    Connection_t::Frame_ptr init = Connection_t::MakeFrame(ToServer::Login::Init<PacketID, PacketID::Init>("AWE_BNCH", 0, Util::LocaleInfo(), ToServer::Login::NextInitStep::Join));
+
+    asio::io_context context;
+    std::vector<asio::ip::tcp::socket> sockets;
+    for(std::size_t i = 0; i < ClientCount; i++)
+    {
+        sockets.emplace_back(context);
+        asio::error_code ec;
+        do
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            sockets.back().close();
+            sockets.back().connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port), ec);
+        } while(ec);
+        asio::write(sockets.back(), init->Body.Frame());
+    }
+
+    std::vector<std::thread> readers;
+    for(asio::ip::tcp::socket& socket : sockets)
+    {
+        readers.emplace_back(
+            [&socket]()
+            {
+                std::vector<uint8_t> buffer(256 * 1024);
+                asio::error_code ec;
+                while(!ec)
+                    socket.read_some(asio::buffer(buffer), ec);
+            }
+        );
+    }
+    for(std::thread& reader : readers)
+        reader.join();
+    _exit(0);
+}
+
+struct Result
+{
+    Util::TrafficStatsSnapshot          Stats;
+    std::chrono::steady_clock::duration Elapsed;
+    std::chrono::duration<double>       Cpu;
+};
+
+/// Broadcast the same frame to every client, as a world chunk would be
+Result Broadcast(std::size_t zeroCopyThreshold, uint16_t port, const Connection_t::Frame_ptr& frame)
+{
+    PacketServerConfiguration config;
+    config.Port              = port;
+    config.MaxPlayers        = ClientCount;
+    config.ZeroCopyThreshold = zeroCopyThreshold;
+    config.IdleTimeout       = std::chrono::milliseconds(0);
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_BNCH", 0);
+    server.Start();
+    while(server.TrafficSnapshot().PacketsIn < ClientCount) // Init
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    auto cpuStart = ProcessCpuTime();
+    auto start    = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < ChunkCount; i++)
+        server.SendFrame_AllClients(frame);
+    while(server.TrafficSnapshot().PacketsOut < ClientCount * ChunkCount)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    Result result;
+    result.Elapsed = std::chrono::steady_clock::now() - start;
+    result.Cpu     = ProcessCpuTime() - cpuStart;
+    result.Stats   = server.TrafficSnapshot();
+    server.Stop();
+    return result; // Connections are closed with the server
+}
+
+void Run(std::size_t zeroCopyThreshold, uint16_t port)
+{
+    pid_t clients = fork();
+    if(clients == 0)
+        RunClients(port);
+
+    Connection_t::Frame_ptr frame = Connection_t::MakeFrame(Chunk{});
+    Result result = Broadcast(zeroCopyThreshold, port, frame);
+    waitpid(clients, nullptr, 0);
+
+    double bytes = static_cast<double>(ClientCount * ChunkCount * frame->Body.Frame().size());
+    std::cout
+        << (zeroCopyThreshold != 0 ? "zero-copy" : "copy     ")
+        << " MB/s=" << static_cast<uint64_t>(bytes / std::chrono::duration<double>(result.Elapsed).count() / 1'000'000)
+        << " CPU ms/GB=" << static_cast<uint64_t>(result.Cpu.count() * 1'000 / (bytes / 1'000'000'000))
+        << " zero-copy sends=" << result.Stats.ZeroCopySends
+        << " copied=" << result.Stats.ZeroCopyCopied
+        << std::endl;
+}
+
+int main()
+{
+    if(!Util::ZeroCopySupported)
+        std::cout << "MSG_ZEROCOPY not supported, both runs copy" << std::endl;
+
+    Run(0, 10115);
+    Run(16 * 1024, 10116);
+}
+#else
+int main()
+{
+    std::cout << "MSG_ZEROCOPY requires Linux" << std::endl;
+}
+#endif
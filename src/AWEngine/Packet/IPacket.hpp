@@ -1,6 +1,7 @@
 #pragma once
 #include <AWEngine/Packet/Util/Core_Packet.hpp>
 
+#include <concepts>
 #include <memory>
 #include <map>
 #include <functional>
@@ -45,16 +46,38 @@ namespace AWEngine::Packet
         virtual void Write(PacketBuffer& out) const = 0;
     };
 
+    /// Packet whose type is known at compile time, sent by templated `Send` without virtual call.
+    /// Requires `static const constexpr TPacketID s_ID` and non-virtual (or final) `void Write(PacketBuffer&) const`,
+    /// optional `static const constexpr uint32_t s_MaxSize` is the largest body `Write` produces and presizes the frame.
+    /// Does not have to derive from `IPacket`, packets which do can be sent both ways.
+    template<typename T, typename TPacketID>
+    concept StaticPacketConcept = requires(const T& packet, PacketBuffer& out)
+    {
+        { T::s_ID } -> std::convertible_to<TPacketID>;
+        packet.Write(out);
+    };
+
+    /// Bytes to reserve for body of `T`, 0 when it does not declare `s_MaxSize`
+    template<typename T>
+    [[nodiscard]] constexpr uint32_t StaticPacketMaxSize() noexcept
+    {
+        if constexpr(requires { { T::s_MaxSize } -> std::convertible_to<uint32_t>; })
+            return T::s_MaxSize;
+        else
+            return 0;
+    }
+
     template<typename T, typename TPacketID>
     concept PacketConcept_ToClient = std::is_base_of<IPacket<TPacketID>, T>::value && T::s_Direction() == ::AWEngine::Packet::PacketDirection::ToClient;
     template<typename T, typename TPacketID>
     concept PacketConcept_ToServer = std::is_base_of<IPacket<TPacketID>, T>::value && T::s_Direction() == ::AWEngine::Packet::PacketDirection::ToServer;
 }
 
+/// Parser of a single packet type, for lists of packets see `Protocol`
 #ifndef AWE_PACKET_PARSER
 #   define AWE_PACKET_PARSER(packet_name, a_packet_enum)\
-    [](::AWEngine::Packet::PacketBuffer& in, ::AWEngine::Packet::PacketID_t id) -> std::unique_ptr<::AWEngine::Packet::IPacket<a_packet_enum>>\
+    [](::AWEngine::Packet::Util::PacketSendInfo& info) -> std::unique_ptr<::AWEngine::Packet::IPacket<a_packet_enum>>\
     {\
-        return std::make_unique<packet_name>(in);\
+        return std::make_unique<packet_name>(info.Body);\
     }
 #endif
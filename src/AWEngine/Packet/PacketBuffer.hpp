@@ -10,6 +10,7 @@
 #include <stdexcept>
 #include <iostream>
 #include <limits>
+#include <utility>
 
 #if CHAR_BIT != 8
     #error "unsupported char size"
@@ -54,21 +55,68 @@ namespace AWEngine::Packet
     public:
         ~PacketBuffer() = default;
 
+        PacketBuffer(const PacketBuffer&) = default;
+        PacketBuffer& operator=(const PacketBuffer&) = default;
+        /// Takes the storage, the other buffer is left empty
+        PacketBuffer(PacketBuffer&& other) noexcept
+            : m_Data(std::move(other.m_Data)),
+              m_StartOffset(std::exchange(other.m_StartOffset, 0)),
+              m_PrefixSize(std::exchange(other.m_PrefixSize, 0))
+        {
+            other.m_Data.clear();
+        }
+        /// Takes the storage, the other buffer is left empty
+        PacketBuffer& operator=(PacketBuffer&& other) noexcept
+        {
+            m_Data        = std::move(other.m_Data);
+            m_StartOffset = std::exchange(other.m_StartOffset, 0);
+            m_PrefixSize  = std::exchange(other.m_PrefixSize, 0);
+            other.m_Data.clear();
+            return *this;
+        }
+
     private:
         /// Byte values
         std::vector<uint8_t> m_Data = {};
         /// Offset of first value in m_Data
         /// Used when reading from start of m_Data to not erase those values all the time which would cause re-allocation
         uint32_t m_StartOffset = 0;
+        /// Number of bytes at the start of m_Data reserved for packet header (see `ReservePrefix`)
+        /// Never part of the values, m_StartOffset is always at least this big
+        uint32_t m_PrefixSize = 0;
     public:
         [[nodiscard]] inline const uint8_t* data()  const noexcept { return m_Data.data() + m_StartOffset; }
         [[nodiscard]] inline       uint8_t* data()        noexcept { return m_Data.data() + m_StartOffset; }
         [[nodiscard]] inline uint32_t       size()  const noexcept { return m_Data.size() - m_StartOffset; }
         [[nodiscard]] inline bool           empty() const noexcept { return size() <= 0; }
-                      inline void           reserve(std::size_t byteCount) { m_Data.reserve(byteCount); }
-                      inline void           resize(std::size_t byteCount)  { m_Data.resize(byteCount); }
+                      inline void           reserve(std::size_t byteCount) { m_Data.reserve(m_StartOffset + byteCount); }
+                      inline void           resize(std::size_t byteCount)  { m_Data.resize(m_StartOffset + byteCount); }
     public:
         [[nodiscard]] inline const std::vector<uint8_t>& Buffer() const noexcept { return m_Data; }
+
+    // Prefix
+    // Space in front of the values so packet header and body can be written to the socket as one contiguous region
+    public:
+        /// Reserve `byteCount` bytes in front of the values.
+        /// Only for empty buffer.
+        inline void ReservePrefix(uint32_t byteCount)
+        {
+            if(!m_Data.empty())
+                throw std::runtime_error("Prefix can only be reserved in empty buffer");
+
+            m_Data.resize(byteCount);
+            m_PrefixSize  = byteCount;
+            m_StartOffset = byteCount;
+        }
+        [[nodiscard]] inline const uint8_t* Prefix()     const noexcept { return m_Data.data(); }
+        [[nodiscard]] inline       uint8_t* Prefix()           noexcept { return m_Data.data(); }
+        [[nodiscard]] inline uint32_t       PrefixSize() const noexcept { return m_PrefixSize; }
+        /// Prefix directly followed by all values, one contiguous region.
+        /// Only for buffers being written, values which were already read would be included too.
+        [[nodiscard]] inline asio::const_buffer Frame() const noexcept
+        {
+            return asio::const_buffer(m_Data.data(), m_Data.size());
+        }
     public:
         inline       uint8_t& operator[](std::size_t index)       { return m_Data[index < 0 ? -1 : index + m_StartOffset]; };
         inline const uint8_t& operator[](std::size_t index) const { return m_Data[index < 0 ? -1 : index + m_StartOffset]; };
@@ -89,17 +137,19 @@ namespace AWEngine::Packet
     private:
         inline void RemoveStartOffset()
         {
-            if(m_StartOffset != 0)
+            if(m_StartOffset != m_PrefixSize)
             {
-                m_Data.erase(m_Data.begin(), m_Data.begin() + m_StartOffset);
-                m_StartOffset = 0;
+                m_Data.erase(m_Data.begin() + m_PrefixSize, m_Data.begin() + m_StartOffset);
+                m_StartOffset = m_PrefixSize;
             }
         }
 
     public:
+        /// Remove all values and the prefix
         inline void Clear()
         {
             m_StartOffset = 0;
+            m_PrefixSize  = 0;
             m_Data.clear();
         }
 
@@ -124,8 +174,7 @@ namespace AWEngine::Packet
             if(m_Data.size() + size > (std::numeric_limits<uint32_t>::max)())
                 throw std::runtime_error("Buffer would be full");
 
-            for(std::size_t i = 0; i < size; i++)
-                m_Data.emplace_back(val[i]);
+            m_Data.insert(m_Data.end(), val, val + size);
         }
 
     // Read
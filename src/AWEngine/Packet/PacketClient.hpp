@@ -12,6 +12,7 @@
 #include "AWEngine/Packet/ToServer/Login/Init.hpp"
 #include "AWEngine/Packet/Util/ThreadSafeQueue.hpp"
 #include "AWEngine/Packet/Util/Connection.hpp"
+#include "AWEngine/Packet/Util/SocketOptions.hpp"
 
 namespace AWEngine::Packet
 {
@@ -65,10 +66,12 @@ namespace AWEngine::Packet
         explicit PacketClient(
             //TODO PacketParser
             ProtocolGameName    gameName,
-            ProtocolGameVersion gameVersion
+            ProtocolGameVersion gameVersion,
+            Util::SocketOptions socketOptions = {}
         )
             : m_GameName(gameName),
-              m_GameVersion(gameVersion)
+              m_GameVersion(gameVersion),
+              m_SocketOptions(socketOptions)
         {
             if(PacketID_Pong != TPacketID(0xF0u))
                 std::cerr << "Warning: Pong packet has non-standard ID" << std::endl;
@@ -80,6 +83,11 @@ namespace AWEngine::Packet
         ~PacketClient()
         {
             Disconnect();
+
+            // Connection may have been closed by the server
+            m_IoContext.stop();
+            if(m_ThreadContext.joinable())
+                m_ThreadContext.join();
         }
 
     private:
@@ -109,12 +117,25 @@ namespace AWEngine::Packet
         asio::ip::tcp::resolver       m_Resolver = asio::ip::tcp::resolver(m_IoContext);
         ProtocolGameName              m_GameName;
         ProtocolGameVersion           m_GameVersion;
+        Util::SocketOptions           m_SocketOptions;
+        Util::DatagramOptions         m_DatagramOptions = {};
+    public:
+        [[nodiscard]] inline const Util::SocketOptions& SocketOptions() const noexcept { return m_SocketOptions; }
+        /// Applied on next `Connect`.
+        inline void SetSocketOptions(const Util::SocketOptions& options) noexcept { m_SocketOptions = options; }
+        [[nodiscard]] inline const Util::DatagramOptions& DatagramOptions() const noexcept { return m_DatagramOptions; }
+        /// Accept the unreliable side channel offered by the server (see `Util/Datagram.hpp`), `Unreliable` must match the server.
+        /// Applied on next `Connect`.
+        inline void SetDatagramOptions(const Util::DatagramOptions& options) noexcept { m_DatagramOptions = options; }
     public:
         [[nodiscard]] inline const Connection_t& Connection() const noexcept { return *m_Connection; }
         [[nodiscard]] inline       Connection_t& Connection()       noexcept { return *m_Connection; }
     public:
         inline void Send(const Packet::IPacket<TPacketID>& packet)                        { m_Connection->Send(packet); }
         inline void Send(const std::unique_ptr<const Packet::IPacket<TPacketID>>& packet) { m_Connection->Send(packet); }
+        /// Send packet of type known at compile time, see `StaticPacketConcept`
+        template<StaticPacketConcept<TPacketID> T>
+        inline void Send(const T& packet) { m_Connection->Send(packet); }
 
     private:
         /// Queue of packets for the client to read from different threads.
@@ -124,6 +145,12 @@ namespace AWEngine::Packet
     public:
         [[nodiscard]] inline Util::ThreadSafeQueue<OwnedMessage_t>& Incoming()    noexcept { return ReceiveQueue; }
         [[nodiscard]] inline bool                                   HasIncoming() noexcept { return !ReceiveQueue.empty(); }
+
+    public:
+        /// Called for every fragment of packets too big for a single frame.
+        /// When set, those packets are not reassembled and never reach `Incoming`.
+        /// Called from the network thread as the fragments arrive, set before `Connect`.
+        std::function<void(const Util::StreamChunk&)> OnStreamChunk;
     };
 
     inline std::ostream& operator<<(std::ostream& out, PacketClientDisconnectReason dr);
@@ -159,6 +186,9 @@ namespace AWEngine::Packet
                 asio::ip::tcp::socket(m_IoContext),
                 ReceiveQueue
             );
+            if(OnStreamChunk)
+                m_Connection->SetStreamChunkHandler(OnStreamChunk);
+            m_Connection->SetDatagramOptions(m_DatagramOptions);
 
             // Tell the connection object to connect to server
             m_Connection->ConnectToServer(
@@ -168,11 +198,12 @@ namespace AWEngine::Packet
                     m_GameVersion,
                     Util::LocaleInfo::Current(),
                     ToServer::Login::NextInitStep::Join
-                )
+                ),
+                m_SocketOptions
             );
 
             // Start Context Thread
-            m_ThreadContext = std::thread([this]() { m_IoContext.run(); });
+            m_ThreadContext = std::thread([this]() { Util::CoarseClock::Run(m_IoContext); });
         }
         catch (std::exception& e)
         {
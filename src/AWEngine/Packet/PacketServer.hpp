@@ -1,10 +1,28 @@
 #pragma once
 #include <AWEngine/Packet/Util/Core_Packet.hpp>
+#include <array>
+#include <atomic>
+#include <deque>
 #include <utility>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "IPacket.hpp"
 #include "ProtocolInfo.hpp"
+#include "ToClient/Kick.hpp"
+#include "ToClient/Login/ServerInfo.hpp"
 #include "Util/Connection.hpp"
+#include "Util/SocketOptions.hpp"
+#include "Util/LatencyHistogram.hpp"
+#include "Util/TrafficStats.hpp"
+#include "Util/ServerShard.hpp"
+#include "Util/ThreadAffinity.hpp"
+#include "Util/Channel.hpp"
+#include "Util/DispatchPool.hpp"
+#include "Util/PacketArena.hpp"
 #include "ProtocolGameName.hpp"
 
 namespace AWEngine::Packet
@@ -14,11 +32,105 @@ namespace AWEngine::Packet
         std::string DisplayName = "Unnamed Server";
         std::string WebsiteUrl  = {};
 
+        /// Maximum number of joined clients, checked on network threads once `Init` with `NextInitStep::Join` is received.
+        /// Clients joining over the limit receive `Kick` with `ServerFullMessage` and are disconnected.
+        /// Status requests are not counted, a full server still answers them.
+        /// 0 = unlimited.
         std::size_t MaxPlayers = 10;
+        /// Maximum number of open client sockets (players, handshakes and status requests), checked before anything is allocated for a new client.
+        /// Sockets over the limit receive `Kick` with `ServerFullMessage` and are closed.
+        /// 0 = twice `MaxPlayers` (unlimited when `MaxPlayers` is).
+        std::size_t MaxConnections = 0;
+        std::string ServerFullMessage = "Server is full";
+        /// Reason of `Kick` sent to clients of a different game or game version trying to join.
+        std::string IncompatibleMessage = "Incompatible game version";
 
         asio::ip::tcp         IP          = asio::ip::tcp::v4();
         static const uint16_t DefaultPort = 10101;
         uint16_t              Port        = DefaultPort;
+
+        /// Maximum length of the queue of pending connections (listen backlog).
+        int ListenBacklog = asio::socket_base::max_listen_connections;
+        /// Number of accept operations waiting for a connection at the same time on every listening socket.
+        /// More of them let a burst of connections (e.g. everyone reconnecting after restart) be accepted in one wake-up of the network thread.
+        std::size_t PendingAccepts = 4;
+        /// Options applied to socket of every accepted client, `ReceiveBufferSize` to the listening sockets.
+        Util::SocketOptions Socket = {};
+
+        /// Number of network threads running the asio context of every shard.
+        /// Work of a single client is always serialized (see `Connection::Strand`), different clients are served in parallel.
+        std::size_t IoThreadCount = 1;
+        /// Number of independent shards, each with own asio context, acceptor, network threads, connections and received messages.
+        /// Shards listen on the same port (SO_REUSEPORT) so the system balances new connections between them.
+        /// Without SO_REUSEPORT only the first shard listens and spreads accepted connections between all shards.
+        /// 0 = one per hardware thread.
+        std::size_t ShardCount = 1;
+        /// Pin network threads to CPU cores, only with more than one shard.
+        bool PinShardThreads = true;
+
+        /// `Send` and `Send_AllClients` only stage packets, they are written by `Flush` in one batch per connection.
+        /// Useful for fixed-tick servers to not wake the network thread on every packet.
+        /// KeepAlive packets are not staged, they are written right away.
+        bool DeferredSend = false;
+        /// Call `Flush` at the end of every `Update` when `DeferredSend` is enabled.
+        bool AutoFlush = true;
+
+        /// Ping clients which did not send anything for this long, clients which keep sending are not pinged.
+        /// Responses are measured in `Connection::Rtt`.
+        /// 0 = disabled.
+        std::chrono::milliseconds KeepAliveInterval = std::chrono::seconds(30);
+        /// Disconnect clients which did not send anything (including responses to KeepAlive) for this long.
+        /// 0 = disabled.
+        std::chrono::milliseconds IdleTimeout       = std::chrono::seconds(45);
+        /// Disconnect clients which did not send their intent to join in this time.
+        /// 0 = disabled.
+        std::chrono::milliseconds HandshakeTimeout  = std::chrono::seconds(10);
+        /// Precision of the timeouts above, they are checked by network threads.
+        std::chrono::milliseconds TimeoutResolution = std::chrono::milliseconds(100);
+
+        /// Number of threads helping `PacketServer::Update` to process received messages.
+        /// Messages of a single client are processed in order, different clients in parallel
+        /// so `OnMessage`, `OnPacket` and the parser may be called from multiple threads at the same time.
+        /// 0 = everything is processed by the thread calling `Update`.
+        std::size_t DispatchThreadCount = 0;
+
+        /// Maximum number of received packets of a single client waiting for `Update`.
+        /// When reached, the server stops reading from the client until `Update` catches up,
+        /// so a client flooding the server cannot make it run out of memory.
+        /// 0 = unlimited, disables the protection.
+        std::size_t MaxPendingPacketsPerClient = 1024;
+
+        /// Body size of a single fragment of packets too big for one frame (see `PacketFlags::Fragment`).
+        /// Smaller value means lower delay of other packets during big transfers.
+        std::size_t FragmentSize      = 16 * 1024;
+        /// Maximum size of fragmented packets being reassembled at the same time for a single client.
+        /// Not used with `OnStreamChunk`.
+        std::size_t MaxReassemblySize = 64 * 1024 * 1024;
+
+        /// Number of receive buffers (`Util::ReceiveBufferPool::SlotSize` each) of every shard, allocated at start.
+        /// Clients with a buffer read everything available at once instead of every header and body separately.
+        /// Clients over the number read directly.
+        /// 0 = disabled.
+        std::size_t ReceiveBuffers = 0;
+
+        /// Frames of at least this size (bytes including header) are sent with MSG_ZEROCOPY (Linux, see `Util::ZeroCopySupported`).
+        /// Saves copying big frames shared by many clients (e.g. `SendFrame_AllClients`), the frame lives until the kernel is done with it.
+        /// Below ~10 KiB copying is cheaper, over loopback the kernel copies anyway. Ignored where not supported.
+        /// 0 = disabled.
+        std::size_t ZeroCopyThreshold = 0;
+
+        /// Unreliable side channel (UDP on `Port`) offered to every joined client, see `Util/Datagram.hpp`.
+        /// Packets listed in `Datagrams.Unreliable` are sent over it once the client answers, clients need the same list.
+        /// Not offered to `CoroutineSessions`.
+        /// All datagrams are received by the network threads of the first shard, sending is done by the thread of each connection.
+        Util::DatagramOptions Datagrams = {};
+
+#ifdef AWE_PACKET_COROUTINE
+        /// Joined clients are returned by `PacketServer::Accept` instead of being processed by `Update`,
+        /// their packets are pulled by coroutines using `Connection::Receive` (see `Connection::SetSessionMode`).
+        /// KeepAlive responses are read only while `Receive` waits, keep `IdleTimeout` above the longest pause between calls.
+        bool CoroutineSessions = false;
+#endif
     };
 
     template<
@@ -39,26 +151,140 @@ namespace AWEngine::Packet
         typedef std::unique_ptr<IPacket<TPacketID>>                             Packet_ptr;
         typedef std::unique_ptr<IPacket<TPacketID_Receive>>                     Packet_Receive_ptr;
         typedef typename Connection_t::OwnedMessage_t                           OwnedMessage_t;
+        typedef typename Connection_t::Frame_ptr                                Frame_ptr;
 
         typedef std::function<Packet_Receive_ptr(Util::PacketSendInfo&)> PacketParser_t; //THINK Convert to class?
+        /// Parser constructing packets in the arena of current `Update` (see `Protocol::ParseInto`)
+        typedef std::function<IPacket<TPacketID_Receive>*(Util::PacketArena&, Util::PacketSendInfo&)> ArenaPacketParser_t;
 
     public:
+        /// Every received packet is parsed into its own heap allocation passed to `OnPacket`
+        PacketServer(
+            PacketServerConfiguration config,
+            PacketParser_t            packetParser,
+            ProtocolGameName          gameName,
+            ProtocolGameVersion       gameVersion
+        )
+            : PacketServer(std::move(config), std::move(packetParser), nullptr, gameName, gameVersion)
+        {
+        }
+        /// Received packets are parsed into an arena reset at the end of every `Update` and passed to `OnArenaPacket`
+        PacketServer(
+            PacketServerConfiguration config,
+            ArenaPacketParser_t       arenaPacketParser,
+            ProtocolGameName          gameName,
+            ProtocolGameVersion       gameVersion
+        )
+            : PacketServer(std::move(config), nullptr, std::move(arenaPacketParser), gameName, gameVersion)
+        {
+        }
+    private:
         PacketServer(
             PacketServerConfiguration config,
             PacketParser_t            packetParser,
+            ArenaPacketParser_t       arenaPacketParser,
             ProtocolGameName          gameName,
             ProtocolGameVersion       gameVersion
         )
             : m_Config(std::move(config)),
               m_Parser(std::move(packetParser)),
-              m_Endpoint(asio::ip::tcp::endpoint(m_Config.IP, m_Config.Port)),
-              m_AsioAcceptor(m_IoContext, m_Endpoint), //TODO Multiple IPs (at least IPv4 and IPv6 at the same time)
+              m_ArenaParser(std::move(arenaPacketParser)),
+              m_Endpoint(asio::ip::tcp::endpoint(m_Config.IP, m_Config.Port)), //TODO Multiple IPs (at least IPv4 and IPv6 at the same time)
               m_GameName(gameName),
-              m_GameVersion(gameVersion)
+              m_GameVersion(gameVersion),
+              m_ServerFullFrame(Connection_t::MakeFrame(ToClient::Kick<TPacketID, PacketID_Kick>(m_Config.ServerFullMessage)))
         {
-            if(!m_Parser)
+            if(!m_Parser && !m_ArenaParser)
                 throw std::runtime_error("No parser provided");
 
+            m_Handshake.GameName     = m_GameName;
+            m_Handshake.GameVersion  = m_GameVersion;
+            m_Handshake.Incompatible = Connection_t::MakeFrame(ToClient::Kick<TPacketID, PacketID_Kick>(m_Config.IncompatibleMessage));
+            m_Handshake.ServerFull   = m_ServerFullFrame;
+            if(m_Config.MaxConnections == 0)
+                m_Config.MaxConnections = 2 * m_Config.MaxPlayers;
+            if(m_Config.MaxPlayers != 0)
+            {
+                m_Handshake.AdmitPlayer   = [this]() { return Reserve(m_Players, m_Config.MaxPlayers); };
+                m_Handshake.ReleasePlayer = [this]() { m_Players.fetch_sub(1, std::memory_order_relaxed); };
+            }
+            m_Handshake.OnStatusServed = [this](const Connection_ptr& connection)
+            {
+                // Never reached the game, forget it right away
+                bool removed;
+                {
+                    Shard_t& shard = *m_Shards[connection->ShardIndex()];
+                    std::scoped_lock lock(shard.ConnectionsMutex);
+                    removed = shard.Connections.Erase(connection->Id().Key);
+                }
+                if(removed)
+                    Release(*connection);
+            };
+#ifdef AWE_PACKET_COROUTINE
+            m_Handshake.OnJoined = [this](const Connection_ptr& connection)
+            {
+                std::scoped_lock lock(m_JoinedMutex);
+                if(m_AcceptSlot.empty())
+                    m_Joined.emplace_back(connection);
+                else
+                    m_AcceptSlot.Complete(asio::error_code{}, connection);
+            };
+#endif
+            SetServerInfo(DefaultServerInfo());
+
+            std::size_t shardCount = m_Config.ShardCount;
+            if(shardCount == 0)
+                shardCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+            m_Shards.reserve(shardCount);
+            for(std::size_t i = 0; i < shardCount; i++)
+            {
+                m_Shards.emplace_back(std::make_unique<Shard_t>(i));
+                m_Shards.back()->MessageInQueue.set_signal(&m_MessageSignal);
+            }
+
+            if(m_Config.ReceiveBuffers != 0)
+                for(auto& shard : m_Shards)
+                    shard->ReceiveBuffers = std::make_shared<Util::ReceiveBufferPool>(m_Config.ReceiveBuffers);
+
+            for(auto& shard : m_Shards)
+            {
+                // Same as constructing the acceptor with the endpoint but with configurable backlog
+                shard->Acceptor.open(m_Endpoint.protocol());
+                shard->Acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
+#if defined(SO_REUSEPORT)
+                if(shardCount > 1)
+                    shard->Acceptor.set_option(Util::ReusePort(true));
+#endif
+                Util::ApplyPreConnectSocketOptions(shard->Acceptor, m_Config.Socket); // Inherited by accepted sockets
+                shard->Acceptor.bind(m_Endpoint);
+                shard->Acceptor.listen(m_Config.ListenBacklog);
+
+                if(!Util::ReusePortSupported)
+                    break;
+            }
+
+            if(m_Config.Datagrams.Enabled)
+            {
+                m_Datagrams = std::make_shared<Util::DatagramSocket>(m_Shards.front()->IoContext, m_Config.Datagrams.SimulatedLoss);
+                m_Datagrams->Open(asio::ip::udp::endpoint(m_Endpoint.address(), m_Endpoint.port()));
+            }
+
+            if(m_Config.DispatchThreadCount != 0)
+            {
+                m_Dispatcher = std::make_unique<Util::DispatchPool<DispatchTask_t>>(
+                    m_Config.DispatchThreadCount,
+                    [this](DispatchTask_t& task, std::size_t worker)
+                    {
+                        for(OwnedMessage_t& msg : task)
+                            Dispatch(msg, m_Arenas[worker]);
+                    }
+                );
+            }
+
+            // Workers never share an arena
+            m_Arenas = std::vector<Util::PacketArena>(m_Dispatcher ? m_Dispatcher->WorkerCount() : 1);
+
             if(PacketID_Ping != TPacketID(0xF0u))
                 std::cerr << "Warning: Ping packet has non-standard ID" << std::endl;
             if(PacketID_Kick != TPacketID(0xFFu))
@@ -67,17 +293,42 @@ namespace AWEngine::Packet
                 std::cerr << "Warning: ServerInfo packet has non-standard ID" << std::endl;
         }
 
+    public:
         ~PacketServer()
         {
             Stop();
+
+            // Connections of every shard may hold the datagram socket living in the context of the first shard
+            m_Datagrams.reset();
+            while(!m_Shards.empty())
+                m_Shards.pop_back();
         }
 
     private:
         PacketServerConfiguration m_Config;
         asio::ip::tcp::endpoint   m_Endpoint;
         PacketParser_t            m_Parser;
+        ArenaPacketParser_t       m_ArenaParser;
         ProtocolGameName          m_GameName;
         ProtocolGameVersion       m_GameVersion;
+        /// `Kick` sent to clients over `MaxPlayers` or `MaxConnections`, serialized once
+        Frame_ptr                 m_ServerFullFrame;
+        /// Shared by all connections, answers status requests on network threads
+        typename Connection_t::ServerHandshake m_Handshake = {};
+
+    public:
+        /// Replace JSON sent to clients requesting server info (see `ToClient::Login::ServerInfo` for the format).
+        /// Serialized once, status requests are then answered by network threads without involving `Update`.
+        /// Can be called from any thread, e.g. periodically to update number of online players.
+        inline void SetServerInfo(std::string json)
+        {
+            m_Handshake.ServerInfo.store(
+                Connection_t::MakeFrame(ToClient::Login::ServerInfo<TPacketID, PacketID_ServerInfo>(m_GameName, m_GameVersion, std::move(json))),
+                std::memory_order_release
+            );
+        }
+        /// Name, website and maximum players from the configuration
+        [[nodiscard]] std::string DefaultServerInfo() const;
 
     public:
         [[nodiscard]] inline const PacketServerConfiguration& Config() const noexcept { return m_Config; }
@@ -86,51 +337,299 @@ namespace AWEngine::Packet
         [[nodiscard]] inline Packet_ptr ParsePacket(Util::PacketSendInfo& info) { return m_Parser ? m_Parser(info) : nullptr; }
 
     private:
-        // Thread Safe Queue for incoming message packets
-        Util::ThreadSafeQueue<OwnedMessage_t> m_MessageInQueue;
+        typedef Util::ServerShard<Connection_t> Shard_t;
+
+        /// Notified when queue of any shard stops being empty (not per message), must outlive the shards
+        Util::QueueSignal                     m_MessageSignal   = {};
+        std::vector<std::unique_ptr<Shard_t>> m_Shards          = {};
+        /// Shard drained first by `Update`, rotates so no shard is preferred when the limit of messages is reached
+        std::size_t                           m_NextUpdateShard = 0;
+        /// Shard to receive next connection accepted by the first shard (without SO_REUSEPORT)
+        std::size_t                           m_NextAcceptShard = 0;
+        /// Sockets counted against `MaxConnections` - in a shard or being added to one
+        std::atomic<std::size_t>              m_Connections     = 0;
+        /// Joined clients counted against `MaxPlayers`
+        std::atomic<std::size_t>              m_Players         = 0;
+    public:
+        [[nodiscard]] inline std::size_t ShardCount() const noexcept { return m_Shards.size(); }
+        /// Joined clients holding a place counted against `MaxPlayers` (only counted when limited)
+        [[nodiscard]] inline std::size_t PlayerCount() const noexcept { return m_Players.load(std::memory_order_relaxed); }
+        /// Any shard has a message waiting for `Update`
+        [[nodiscard]] inline bool HasIncoming()
+        {
+            for(auto& shard : m_Shards)
+                if(!shard->MessageBatch.empty() || !shard->MessageInQueue.empty())
+                    return true;
+            return false;
+        }
+
+    public:
+        /// Round-trip times of connections of a single shard
+        [[nodiscard]] inline const Util::LatencyHistogram& Latency(std::size_t shard) const noexcept { return m_Shards[shard]->Latency; }
+        /// Round-trip time percentile of all connections
+        [[nodiscard]] inline std::chrono::nanoseconds LatencyPercentile(double quantile) const noexcept
+        {
+            if(m_Shards.size() == 1)
+                return m_Shards[0]->Latency.Percentile(quantile);
+
+            Util::LatencyHistogram merged;
+            for(auto& shard : m_Shards)
+                merged.Merge(shard->Latency);
+            return merged.Percentile(quantile);
+        }
+        [[nodiscard]] inline std::chrono::nanoseconds LatencyP50() const noexcept { return LatencyPercentile(0.50); }
+        [[nodiscard]] inline std::chrono::nanoseconds LatencyP99() const noexcept { return LatencyPercentile(0.99); }
+
+    public:
+        /// Sum of traffic of connections of a single shard
+        [[nodiscard]] inline const Util::TrafficStats& Traffic(std::size_t shard) const noexcept { return m_Shards[shard]->Traffic; }
+        /// Sum of traffic of all connections
+        [[nodiscard]] inline Util::TrafficStatsSnapshot TrafficSnapshot() const noexcept
+        {
+            Util::TrafficStatsSnapshot snapshot = {};
+            for(auto& shard : m_Shards)
+                snapshot += shard->Traffic.Snapshot();
+            return snapshot;
+        }
 
-        // Container of active validated connections
-        std::deque<Connection_ptr> m_Connections;
+    private:
+        /// Guards `m_Channels` and `m_ChannelMemberships`, locked before `ServerShard::ConnectionsMutex`
+        std::mutex                                                           m_ChannelsMutex      = {};
+        Util::SlotMap<Util::Channel>                                         m_Channels           = {};
+        /// Channels joined by every client, to leave them when the client disconnects
+        std::unordered_map<Util::ConnectionId, std::vector<Util::ChannelId>> m_ChannelMemberships = {};
+    public:
+        /// Create an empty channel.
+        [[nodiscard]] Util::ChannelId CreateChannel();
+        /// Remove the channel and all its members.
+        /// Returns false when the channel does not exist (anymore).
+        bool DestroyChannel(const Util::ChannelId& channel);
+        /// Subscribe client to packets sent to the channel.
+        /// Returns false when the channel or the client does not exist (anymore) or the client is already a member.
+        /// Clients leave all channels automatically when they disconnect.
+        bool JoinChannel(const Util::ChannelId& channel, const Util::ConnectionId& client);
+        /// Returns false when the client is not a member of the channel.
+        bool LeaveChannel(const Util::ChannelId& channel, const Util::ConnectionId& client);
+        /// Number of members of the channel, 0 when the channel does not exist.
+        [[nodiscard]] std::size_t ChannelSize(const Util::ChannelId& channel);
+        /// Send a message to all members of the channel, the packet is serialized only once.
+        /// Returns number of clients the packet was sent to.
+        inline std::size_t SendToChannel(const Util::ChannelId& channel, const IPacket<TPacketID>& packet) { return SendFrameToChannel(channel, Connection_t::MakeFrame(packet)); }
+        /// Send a message to all members of the channel, see `StaticPacketConcept`.
+        template<StaticPacketConcept<TPacketID> T>
+        inline std::size_t SendToChannel(const Util::ChannelId& channel, const T& packet) { return SendFrameToChannel(channel, Connection_t::MakeFrame(packet)); }
+        /// Send packet serialized by `Connection_t::MakeFrame` to all members of the channel.
+        std::size_t SendFrameToChannel(const Util::ChannelId& channel, const Frame_ptr& frame);
+    private:
+        /// Client was removed from its shard, clean up after it and let the user know.
+        /// Called without any lock held.
+        void OnClientRemoved(const Connection_ptr& client);
+        /// Let the user know about clients removed by network threads
+        void ProcessRemoved();
+        /// Dispatch up to `maximumMessages` received messages, all handlers are finished when it returns
+        std::size_t ProcessMessages(std::size_t maximumMessages);
+        /// Returns whether there are messages, false when `deadline` passed first
+        bool WaitUntil(Util::CoarseClock::time_point deadline);
+    public:
+        /// Messages processed by `Update(budget)` between checks of the clock (per dispatch worker)
+        static const constexpr std::size_t UpdateBudgetBatch = 16;
 
-        // Order of declaration is important - it is also the order of initialisation
-        asio::io_context m_IoContext;
-        std::thread      m_ThreadContext;
+    // Parallel dispatch of received messages (see `PacketServerConfiguration::DispatchThreadCount`)
+    private:
+        /// Clients removed by timeout checks, reused by `Update`
+        std::deque<Connection_ptr> m_Removed = {};
+        /// Messages of a single client from a single `Update`, in order
+        typedef std::vector<OwnedMessage_t> DispatchTask_t;
 
-        // These things need an asio context
-        asio::ip::tcp::acceptor m_AsioAcceptor; // Handles new incoming connection attempts...
+        std::unique_ptr<Util::DispatchPool<DispatchTask_t>> m_Dispatcher        = nullptr;
+        /// Packets parsed by `m_ArenaParser` during current `Update`, one per worker of `m_Dispatcher`
+        std::vector<Util::PacketArena>                      m_Arenas            = {};
+        /// Reused by `Update`
+        std::vector<DispatchTask_t>                         m_DispatchTasks     = {};
+        std::unordered_map<const Connection_t*, std::size_t> m_DispatchTaskIndex = {};
+    private:
+        /// Pass message to `OnMessage` and `OnPacket` (or `OnArenaPacket`)
+        void Dispatch(OwnedMessage_t& msg, Util::PacketArena& arena);
 
-        std::chrono::system_clock::duration KeepAliveDelay    = std::chrono::seconds(30);
-        std::chrono::system_clock::duration KeepAliveMaxDelay = std::chrono::seconds(45);
+    // Timeouts are checked per connection on a timer wheel of its shard (see `ServerShard::Timers`).
+    // A check only looks at the time of the last received message, so receiving costs nothing extra
+    // and a check of an active client just schedules the next one.
+    private:
+        [[nodiscard]] inline bool TimeoutsEnabled() const noexcept
+        {
+            return m_Config.KeepAliveInterval.count() != 0 || m_Config.IdleTimeout.count() != 0 || m_Config.HandshakeTimeout.count() != 0;
+        }
+        /// Tick of `ServerShard::Timers` in which `time` is reached
+        [[nodiscard]] inline uint64_t TimerTickOf(const Shard_t& shard, Util::CoarseClock::time_point time) const noexcept
+        {
+            if(time <= shard.TimerEpoch)
+                return 0;
+            auto ticks = (time - shard.TimerEpoch + m_Config.TimeoutResolution - Util::CoarseClock::duration(1)) / m_Config.TimeoutResolution;
+            return static_cast<uint64_t>(ticks);
+        }
+        /// ASYNC - Advance timers of the shard after `TimeoutResolution`
+        void TickTimers(Shard_t& shard);
+        /// Disconnects the client or sends it KeepAlive when it is time.
+        /// Returns false when the client was disconnected, `next` is the time of the next check (max = none).
+        bool CheckTimeouts(Connection_t& connection, Util::CoarseClock::time_point now, Util::CoarseClock::time_point& next);
 
     public:
         /// Starts the server!
         bool Start();
         /// Stops the server!
         void Stop();
+#ifdef AWE_PACKET_COROUTINE
+    private:
+        /// Guards `m_Joined`, `m_AcceptSlot` and `m_AcceptStopped`
+        std::mutex                                                          m_JoinedMutex   = {};
+        /// Joined clients not returned by `Accept` yet
+        std::deque<Connection_ptr>                                          m_Joined        = {};
+        Util::CompletionSlot<void(asio::error_code, Connection_ptr)>        m_AcceptSlot    = {};
+        bool                                                                m_AcceptStopped = true;
+    public:
+        /// Wait for next joined client, only with `CoroutineSessions`.
+        /// Completion signature `void(asio::error_code, Connection_ptr)`, fails with `asio::error::operation_aborted` once the server stops.
+        /// Serve the client from its strand, e.g. `asio::co_spawn(connection->Strand(), Session(connection), asio::detached);`.
+        template<typename TToken = asio::use_awaitable_t<>>
+        inline auto Accept(TToken token = {})
+        {
+            return asio::async_initiate<TToken, void(asio::error_code, Connection_ptr)>(
+                [this](auto handler)
+                {
+                    std::scoped_lock lock(m_JoinedMutex);
+                    if(!m_AcceptSlot.empty())
+                    {
+                        Util::CompletionSlot<void(asio::error_code, Connection_ptr)> rejected;
+                        rejected.Set(std::move(handler), m_Shards.front()->IoContext.get_executor());
+                        rejected.Complete(asio::error::in_progress, nullptr);
+                        return;
+                    }
+
+                    m_AcceptSlot.Set(std::move(handler), m_Shards.front()->IoContext.get_executor());
+                    if(!m_Joined.empty())
+                    {
+                        Connection_ptr connection = std::move(m_Joined.front());
+                        m_Joined.pop_front();
+                        m_AcceptSlot.Complete(asio::error_code{}, std::move(connection));
+                    }
+                    else if(m_AcceptStopped)
+                    {
+                        m_AcceptSlot.Complete(asio::error::operation_aborted, nullptr);
+                    }
+                },
+                token
+            );
+        }
+#endif
     private:
         /// ASYNC - Instruct asio to wait for connection
-        void WaitForClientConnection();
+        /// Called from `AcceptStrand` of the shard (or before network threads start).
+        void WaitForClientConnection(Shard_t& shard);
+        /// Reserve place in a counter with a limit, false when it is full (0 = unlimited)
+        [[nodiscard]] static inline bool Reserve(std::atomic<std::size_t>& counter, std::size_t limit) noexcept
+        {
+            if(limit == 0)
+            {
+                counter.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            std::size_t count = counter.load(std::memory_order_relaxed);
+            do
+            {
+                if(count >= limit)
+                    return false;
+            }
+            while(!counter.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+            return true;
+        }
+        /// Connection counted by `Reserve` was removed from its shard (or never added), returns its places
+        inline void Release(Connection_t& connection) noexcept
+        {
+            m_Connections.fetch_sub(1, std::memory_order_relaxed);
+            if(connection.ReleasePlayer())
+                m_Players.fetch_sub(1, std::memory_order_relaxed);
+        }
+        /// Send pre-serialized `Kick` to a client over `MaxConnections` and close the socket, nothing is allocated for the client.
+        /// Best effort - the client may not receive the reason when its socket is not ready.
+        void RejectFull(Shard_t& shard, asio::ip::tcp::socket& socket);
+
+    private:
+        /// Side channel of all clients, received by the first shard, see `PacketServerConfiguration::Datagrams`
+        std::shared_ptr<Util::DatagramSocket>      m_Datagrams      = nullptr;
+        std::array<uint8_t, Util::MaxDatagramSize> m_DatagramBuffer = {};
+        asio::ip::udp::endpoint                    m_DatagramSender = {};
+        /// ASYNC - Receive next datagram and pass it to its connection
+        void ReadDatagram();
     public:
+        /// Connection of a client, `nullptr` when the client is not connected anymore.
+        [[nodiscard]] Connection_ptr Find(const Util::ConnectionId& id);
+        /// Number of clients of all shards.
+        [[nodiscard]] std::size_t ConnectionCount();
+    public:
+        /// Send a message to a specific client.
+        inline void Send(const Connection_ptr& client, const IPacket<TPacketID>& packet) { SendFrame(client, Connection_t::MakeFrame(packet)); }
         /// Send a message to a specific client.
-        void Send(const Connection_ptr& client, const IPacket<TPacketID>& packet);
-        /// Send packet to all clients.
-        void Send_AllClients(const IPacket<TPacketID>& packet, const Connection_ptr& ignoredClient = nullptr);
+        /// Returns false when the client is not connected anymore.
+        bool Send(const Util::ConnectionId& id, const IPacket<TPacketID>& packet);
+        /// Send a message to listed clients, the packet is serialized only once.
+        /// Returns number of clients the packet was sent to (disconnected ones are skipped).
+        inline std::size_t Send(std::span<const Util::ConnectionId> clients, const IPacket<TPacketID>& packet) { return clients.empty() ? 0 : SendFrame(clients, Connection_t::MakeFrame(packet)); }
+        /// Send packet to all clients, the packet is serialized only once.
+        inline void Send_AllClients(const IPacket<TPacketID>& packet, const Connection_ptr& ignoredClient = nullptr) { SendFrame_AllClients(Connection_t::MakeFrame(packet), ignoredClient); }
+    public:
+        // Packets of types known at compile time, serialized without virtual call (see `StaticPacketConcept`)
+        template<StaticPacketConcept<TPacketID> T>
+        inline void Send(const Connection_ptr& client, const T& packet) { SendFrame(client, Connection_t::MakeFrame(packet)); }
+        template<StaticPacketConcept<TPacketID> T>
+        inline bool Send(const Util::ConnectionId& id, const T& packet)
+        {
+            Connection_ptr client = Find(id);
+            if(!client)
+                return false;
+
+            Send(client, packet);
+            return true;
+        }
+        template<StaticPacketConcept<TPacketID> T>
+        inline std::size_t Send(std::span<const Util::ConnectionId> clients, const T& packet) { return clients.empty() ? 0 : SendFrame(clients, Connection_t::MakeFrame(packet)); }
+        template<StaticPacketConcept<TPacketID> T>
+        inline void Send_AllClients(const T& packet, const Connection_ptr& ignoredClient = nullptr) { SendFrame_AllClients(Connection_t::MakeFrame(packet), ignoredClient); }
+    public:
+        // Packets serialized by `Connection_t::MakeFrame`, one frame can be sent any number of times
+        void SendFrame(const Connection_ptr& client, const Frame_ptr& frame);
+        std::size_t SendFrame(std::span<const Util::ConnectionId> clients, const Frame_ptr& frame);
+        void SendFrame_AllClients(const Frame_ptr& frame, const Connection_ptr& ignoredClient = nullptr);
+    public:
         /// Force server to respond to incoming messages.
+        /// With `DispatchThreadCount`, all handlers of the processed messages are finished when it returns.
         std::size_t Update(size_t maximumMessages = -1, bool waitForMessage = false);
-        /// Sends KeepAlive packet to all clients.
+        /// Process incoming messages until all are processed or `budget` is spent, e.g. `Update(std::chrono::milliseconds(2))` in a game loop.
+        /// The budget is checked after every `UpdateBudgetBatch` messages (per dispatch worker) so it is exceeded by at most one batch of handlers.
+        /// Messages left over are processed first by the next `Update`.
+        std::size_t Update(Util::CoarseClock::duration budget);
+        /// Wait until a message arrives or `timeout` passes, returns whether there are messages for `Update`.
+        /// Woken by a message arriving into empty shard queue, with no lock taken by network threads while nobody waits
+        /// and nothing shared between shards touched while their queues are not empty.
+        inline bool WaitFor(Util::CoarseClock::duration timeout) { return WaitUntil(Util::CoarseClock::PreciseNow() + timeout); }
+        /// Sends KeepAlive packet to all clients which did not send anything for `KeepAliveInterval` and removes the timed out ones.
+        /// Not needed unless automatic timeouts are disabled, costs O(clients).
         void SendKeepAlive();
+        /// Write packets staged in `DeferredSend` mode to all clients.
+        void Flush();
 
     public:
         /// Called when a client connects, you can veto the connection by returning false.
         /// Use to ban based on IP address (based on local cache).
         /// Called before receiving intent - join or server info.
+        /// `Connection::Id` is not assigned yet.
+        /// Called from a network thread, with multiple shards it may be called for different shards at the same time.
         /// Leave empty to accept all
         std::function<bool(const Connection_ptr&)> OnClientConnect;
         /// Called after receiving client's intent to join.
         std::function<void(const Connection_ptr&)> OnClientJoin;
-        /// Called after receiving client's intent to retrieve info.
-        std::function<std::string(const Connection_ptr&)> OnClientServerInfoRequest;
         /// Called when a client appears to have disconnected.
+        /// Not called for clients which only requested server info, those are answered by `SetServerInfo` on network threads.
         std::function<void(const Connection_ptr&)> OnClientDisconnect;
         /// Called when a message arrives.
         /// Processed during `Update` not when received.
@@ -139,6 +638,14 @@ namespace AWEngine::Packet
         /// Called when a message arrives and is processed into a packet.
         /// Processed during `Update` not when received.
         std::function<void(const Connection_ptr&, Packet_ptr&)> OnPacket;
+        /// Called when a message arrives and is processed into a packet by the arena parser.
+        /// The packet is valid until the end of `Update`, do not keep any reference to it.
+        std::function<void(const Connection_ptr&, IPacket<TPacketID_Receive>&)> OnArenaPacket;
+        /// Called for every fragment of packets too big for a single frame.
+        /// When set, those packets are not reassembled and never reach `OnMessage` or `OnPacket`.
+        /// Called from network threads as the fragments arrive, set before `Start`.
+        /// With multiple network threads it may be called for different clients at the same time.
+        std::function<void(const Connection_ptr&, const Util::StreamChunk&)> OnStreamChunk;
     };
 }
 
@@ -153,14 +660,56 @@ namespace AWEngine::Packet
     >
     bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Start()
     {
+#ifdef AWE_PACKET_COROUTINE
+        {
+            std::scoped_lock lock(m_JoinedMutex);
+            m_AcceptStopped = false;
+        }
+#endif
+
         try
         {
             // Issue a task to the asio context - This is important as it will prime the context with "work", and stop it from exiting immediately.
             // Since this is a server, we want it primed ready to handle clients trying to connect.
-            WaitForClientConnection();
+            // Network threads are not running yet, so the strand is not needed
+            for(auto& shard : m_Shards)
+                if(shard->Acceptor.is_open())
+                    for(std::size_t i = 0; i < (std::max)(m_Config.PendingAccepts, std::size_t(1)); i++)
+                        WaitForClientConnection(*shard);
+            if(m_Datagrams)
+                ReadDatagram();
+
+            if(TimeoutsEnabled())
+            {
+                if(m_Config.TimeoutResolution.count() <= 0)
+                    throw std::runtime_error("Invalid timeout resolution");
+
+                for(auto& shard : m_Shards)
+                {
+                    shard->TimerEpoch = Util::CoarseClock::Now();
+                    TickTimers(*shard);
+                }
+            }
+
+            // Launch the asio context of every shard in its own threads
+            std::size_t threadCount = (std::max)(m_Config.IoThreadCount, std::size_t(1));
+            bool        pinThreads  = m_Config.PinShardThreads && m_Shards.size() > 1;
+            for(auto& shard : m_Shards)
+            {
+                shard->Threads.reserve(threadCount);
+                for(std::size_t i = 0; i < threadCount; i++)
+                {
+                    shard->Threads.emplace_back(
+                        [&context = shard->IoContext, core = shard->Index * threadCount + i, pinThreads]()
+                        {
+                            if(pinThreads && !Util::PinCurrentThread(core))
+                                std::cerr << "Failed to pin network thread to core " << core << std::endl;
 
-            // Launch the asio context in its own thread
-            m_ThreadContext = std::thread([this]() { m_IoContext.run(); });
+                            Util::CoarseClock::Run(context);
+                        }
+                    );
+                }
+            }
         }
         catch (std::exception& ex)
         {
@@ -183,12 +732,27 @@ namespace AWEngine::Packet
     >
     void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Stop()
     {
-        // Request the context to close
-        m_IoContext.stop();
+#ifdef AWE_PACKET_COROUTINE
+        {
+            std::scoped_lock lock(m_JoinedMutex);
+            m_AcceptStopped = true;
+            m_Joined.clear();
+            m_AcceptSlot.Complete(asio::error::operation_aborted, nullptr);
+        }
+#endif
 
-        // Tidy up the context thread
-        if (m_ThreadContext.joinable())
-            m_ThreadContext.join();
+        // Request the contexts to close
+        for(auto& shard : m_Shards)
+            shard->IoContext.stop();
+
+        // Tidy up the context threads
+        for(auto& shard : m_Shards)
+        {
+            for(std::thread& thread : shard->Threads)
+                if (thread.joinable())
+                    thread.join();
+            shard->Threads.clear();
+        }
 
         // Inform someone, anybody, if they care...
         AWE_DEBUG_COUT("Server stopped!");
@@ -201,33 +765,85 @@ namespace AWEngine::Packet
         TPacketID PacketID_Kick,
         TPacketID PacketID_ServerInfo
     >
-    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::WaitForClientConnection()
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::WaitForClientConnection(Shard_t& shard)
     {
+        // Connection is owned by the accepting shard unless it is the only one listening
+        Shard_t& target = Util::ReusePortSupported ? shard : *m_Shards[m_NextAcceptShard++ % m_Shards.size()];
+
         // Prime context with an instruction to wait until a socket connects.
         // This is the purpose of an "acceptor" object.
         // It will provide a unique socket for each incoming connection attempt.
-        m_AsioAcceptor.async_accept(
-            [this](std::error_code ec, asio::ip::tcp::socket socket)
+        // Handlers of multiple pending accepts are serialized by the strand, the acceptor is not thread-safe
+        shard.Acceptor.async_accept(
+            target.IoContext,
+            asio::bind_executor(shard.AcceptStrand, [this, &shard, &target](std::error_code ec, asio::ip::tcp::socket socket)
             {
                 // Triggered by incoming connection request
-                if (!ec)
+                if (ec)
+                {
+                    // Error has occurred during acceptance
+                    std::cout << "Server - new connection error: " << ec.message() << "\n";
+                }
+                else if(!Reserve(m_Connections, m_Config.MaxConnections))
+                {
+                    AWE_DEBUG_COUT("Connection from " << socket.remote_endpoint() << " denied - server is full");
+                    RejectFull(shard, socket);
+                }
+                else
                 {
                     // Display some useful(?) information
                     AWE_DEBUG_COUT("New connection from " << socket.remote_endpoint());
 
+                    Util::ApplySocketOptions(socket, m_Config.Socket);
+
                     // Create a new connection to handle this client
                     std::shared_ptr<Connection_t> newConnection = std::make_shared<Connection_t>(
                         PacketDirection::ToClient,
-                        m_IoContext,
+                        target.IoContext,
                         std::move(socket),
-                        m_MessageInQueue
+                        target.MessageInQueue
                     );
+                    newConnection->SetDeferredSend(m_Config.DeferredSend);
+                    newConnection->SetHandshake(&m_Handshake);
+#ifdef AWE_PACKET_COROUTINE
+                    newConnection->SetSessionMode(m_Config.CoroutineSessions);
+#endif
+                    newConnection->SetServerLatency(&target.Latency);
+                    newConnection->SetServerStats(&target.Traffic);
+                    newConnection->SetMaxPendingIncoming(m_Config.MaxPendingPacketsPerClient);
+                    newConnection->SetFragmentSize(m_Config.FragmentSize);
+                    newConnection->SetMaxReassemblySize(m_Config.MaxReassemblySize);
+                    if(target.ReceiveBuffers)
+                        if(std::optional<std::size_t> slot = target.ReceiveBuffers->Acquire())
+                            newConnection->SetReceiveBuffer(target.ReceiveBuffers, *slot);
+                    if(m_Config.ZeroCopyThreshold != 0)
+                        newConnection->SetZeroCopyThreshold(m_Config.ZeroCopyThreshold);
+                    if(m_Datagrams)
+                        newConnection->SetDatagramOptions(m_Config.Datagrams, m_Datagrams);
+                    if(OnStreamChunk)
+                    {
+                        newConnection->SetStreamChunkHandler(
+                            [this, weakConnection = std::weak_ptr<Connection_t>(newConnection)](const Util::StreamChunk& chunk)
+                            {
+                                if(auto connection = weakConnection.lock())
+                                    OnStreamChunk(connection, chunk);
+                            }
+                        );
+                    }
 
                     // Give the user server a chance to deny connection
                     if (!OnClientConnect || OnClientConnect(newConnection))
                     {
                         // Connection allowed, so add to container of new connections
-                        m_Connections.push_back(newConnection);
+                        {
+                            std::scoped_lock lock(target.ConnectionsMutex);
+                            Util::SlotMapKey key = target.Connections.Insert(newConnection);
+                            newConnection->SetId({ static_cast<uint32_t>(target.Index), key });
+                        }
+
+                        // Timers of the target shard are owned by its strand
+                        if(TimeoutsEnabled())
+                            asio::post(target.TimerStrand, [&target, key = newConnection->Id().Key]() { target.Timers.Schedule(0, key); });
 
                         // And very important!
                         // Issue a task to the connection's asio context to sit and wait for bytes to arrive!
@@ -238,18 +854,44 @@ namespace AWEngine::Packet
                     else
                     {
                         AWE_DEBUG_COUT("Connection from " << newConnection->RemoteEndpoint() << " denied");
+                        Release(*newConnection);
 
                         // Connection will go out of scope with no pending tasks, so will get destroyed automagically due to the wonder of smart pointers
                     }
                 }
-                else
-                {
-                    // Error has occurred during acceptance
-                    std::cout << "Server - new connection error: " << ec.message() << "\n";
-                }
 
                 // Prime the asio context with more work - again simply wait for another connection...
-                WaitForClientConnection();
+                WaitForClientConnection(shard);
+            })
+        );
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::ReadDatagram()
+    {
+        // Single receive at a time, the buffer is not shared
+        m_Datagrams->Socket.async_receive_from(
+            asio::buffer(m_DatagramBuffer),
+            m_DatagramSender,
+            [this](asio::error_code ec, std::size_t size)
+            {
+                if(ec == asio::error::operation_aborted || !m_Datagrams->Socket.is_open())
+                    return;
+
+                // Malformed datagrams and those of unknown clients are ignored, the sender learns nothing.
+                // ID comes from anyone who can reach the port - it is only looked up, the connection checks the token.
+                if(!ec)
+                    if(std::optional<Util::DatagramView> datagram = Util::DatagramView::Parse(m_DatagramBuffer.data(), size))
+                        if(Connection_ptr connection = Find(datagram->Header.Id))
+                            connection->ReceiveDatagram(m_DatagramSender, *datagram);
+
+                ReadDatagram();
             }
         );
     }
@@ -261,26 +903,270 @@ namespace AWEngine::Packet
         TPacketID PacketID_Kick,
         TPacketID PacketID_ServerInfo
     >
-    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Send(const Connection_ptr& client, const IPacket<TPacketID>& packet)
+    std::string PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::DefaultServerInfo() const
+    {
+        auto quote = [](const std::string& text)
+        {
+            std::string quoted = "\"";
+            for(char c : text)
+            {
+                if(c == '"' || c == '\\')
+                    quoted += '\\';
+                if(static_cast<unsigned char>(c) >= 0x20)
+                    quoted += c;
+            }
+            return quoted + "\"";
+        };
+
+        std::string json = "{\"" + ToClient::Login::ServerInfo_Utils::Field_ServerName + "\": " + quote(m_Config.DisplayName);
+        if(!m_Config.WebsiteUrl.empty())
+            json += ", \"" + ToClient::Login::ServerInfo_Utils::Field_Website + "\": " + quote(m_Config.WebsiteUrl);
+        if(m_Config.MaxPlayers != 0)
+            json += ", \"players\": { \"max\": " + std::to_string(m_Config.MaxPlayers) + " }";
+        return json + "}";
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::RejectFull(Shard_t& shard, asio::ip::tcp::socket& socket)
+    {
+        Util::TrafficStats::Add(shard.Traffic.Rejected, 1);
+
+        // Errors only mean the client does not learn why it was disconnected
+        asio::error_code ec;
+        socket.non_blocking(true, ec);
+
+        // Closing a socket with unread data (e.g. Init sent right after connecting) resets the connection and the Kick could be lost
+        std::array<uint8_t, 512> discard; // NOLINT(cppcoreguidelines-pro-type-member-init)
+        while(socket.receive(asio::buffer(discard), 0, ec) > 0) {}
+
+        // New socket has empty send buffer, the small frame fits without waiting
+        socket.send(m_ServerFullFrame->Body.Frame(), 0, ec);
+        socket.shutdown(asio::socket_base::shutdown_both, ec);
+        socket.close(ec);
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::SendFrame(const Connection_ptr& client, const Frame_ptr& frame)
     {
         // Check client is legitimate...
         if (client && client->IsConnected())
         {
             // ...and post the message via the connection
-            client->Send(packet);
+            client->SendFrame(frame);
         }
-        else
+        else if(client)
         {
-            // If we can't communicate with client then we may as well remove the client - let the server know, it may be tracking it somehow
-            if(OnClientDisconnect)
-                OnClientDisconnect(client);
-
+            // If we can't communicate with client then we may as well remove the client
             // Off you go now, bye bye!
-            client.reset();
+            bool removed;
+            {
+                Shard_t& shard = *m_Shards[client->ShardIndex()];
+                std::scoped_lock lock(shard.ConnectionsMutex);
+                removed = shard.Connections.Erase(client->Id().Key);
+            }
+            // Let the server know (only once), it may be tracking it somehow
+            if(removed)
+            {
+                Release(*client);
+                OnClientRemoved(client);
+            }
+        }
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Send(const Util::ConnectionId& id, const IPacket<TPacketID>& packet)
+    {
+        Connection_ptr client = Find(id);
+        if(!client)
+            return false;
+
+        Send(client, packet);
+        return true;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    typename PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Connection_ptr PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Find(const Util::ConnectionId& id)
+    {
+        if(id.Shard >= m_Shards.size())
+            return nullptr;
+
+        Shard_t& shard = *m_Shards[id.Shard];
+        std::scoped_lock lock(shard.ConnectionsMutex);
+        const Connection_ptr* connection = shard.Connections.Find(id.Key);
+        return connection ? *connection : nullptr;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::ConnectionCount()
+    {
+        std::size_t count = 0;
+        for(auto& shard : m_Shards)
+        {
+            std::scoped_lock lock(shard->ConnectionsMutex);
+            count += shard->Connections.size();
+        }
+        return count;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::SendFrame(std::span<const Util::ConnectionId> clients, const Frame_ptr& frame)
+    {
+        if(clients.empty())
+            return 0;
+
+        // Every shard is locked only once
+        std::size_t sent = 0;
+        for(auto& shard : m_Shards)
+        {
+            std::scoped_lock lock(shard->ConnectionsMutex);
+            if(shard->Connections.empty())
+                continue;
+
+            for(const Util::ConnectionId& id : clients)
+            {
+                if(id.Shard != shard->Index)
+                    continue;
+
+                const Connection_ptr* connection = shard->Connections.Find(id.Key);
+                if(connection && (*connection)->IsConnected())
+                {
+                    (*connection)->SendFrame(frame);
+                    sent++;
+                }
+            }
+        }
+        return sent;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    Util::ChannelId PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::CreateChannel()
+    {
+        std::scoped_lock lock(m_ChannelsMutex);
+        return m_Channels.Insert({});
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::DestroyChannel(const Util::ChannelId& channel)
+    {
+        std::scoped_lock lock(m_ChannelsMutex);
+        const Util::Channel* found = m_Channels.Find(channel);
+        if(!found)
+            return false;
 
-            // Then physically remove it from the container
-            m_Connections.erase(std::remove(m_Connections.begin(), m_Connections.end(), client), m_Connections.end());
+        for(const Util::ConnectionId& client : found->Members())
+        {
+            auto it = m_ChannelMemberships.find(client);
+            std::erase(it->second, channel);
+            if(it->second.empty())
+                m_ChannelMemberships.erase(it);
         }
+
+        return m_Channels.Erase(channel);
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::JoinChannel(const Util::ChannelId& channel, const Util::ConnectionId& client)
+    {
+        // Locked before the lookup so a disconnect of the client cannot slip between the lookup and the join
+        std::scoped_lock lock(m_ChannelsMutex);
+        Util::Channel* found = m_Channels.Find(channel);
+        if(!found || !Find(client))
+            return false;
+
+        if(!found->Join(client))
+            return false;
+
+        m_ChannelMemberships[client].emplace_back(channel);
+        return true;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::LeaveChannel(const Util::ChannelId& channel, const Util::ConnectionId& client)
+    {
+        std::scoped_lock lock(m_ChannelsMutex);
+        Util::Channel* found = m_Channels.Find(channel);
+        if(!found || !found->Leave(client))
+            return false;
+
+        auto it = m_ChannelMemberships.find(client);
+        std::erase(it->second, channel);
+        if(it->second.empty())
+            m_ChannelMemberships.erase(it);
+        return true;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::ChannelSize(const Util::ChannelId& channel)
+    {
+        std::scoped_lock lock(m_ChannelsMutex);
+        const Util::Channel* found = m_Channels.Find(channel);
+        return found ? found->size() : 0;
     }
 
     template<
@@ -290,41 +1176,125 @@ namespace AWEngine::Packet
         TPacketID PacketID_Kick,
         TPacketID PacketID_ServerInfo
     >
-    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Send_AllClients(const IPacket<TPacketID>& packet, const Connection_ptr& ignoredClient)
+    std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::SendFrameToChannel(const Util::ChannelId& channel, const Frame_ptr& frame)
     {
-        bool invalidClientExists = false;
+        std::scoped_lock lock(m_ChannelsMutex);
+        const Util::Channel* found = m_Channels.Find(channel);
+        if(!found)
+            return 0;
+
+        return SendFrame(found->Members(), frame);
+    }
 
-        // Iterate through all clients in container
-        for(auto& connection : m_Connections)
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::OnClientRemoved(const Connection_ptr& client)
+    {
         {
-            // Check client is connected...
-            if(connection && connection->IsConnected())
+            std::scoped_lock lock(m_ChannelsMutex);
+            auto it = m_ChannelMemberships.find(client->Id());
+            if(it != m_ChannelMemberships.end())
             {
-                // ..it is!
-                if(connection != ignoredClient)
-                    connection->Send(packet);
+                for(const Util::ChannelId& channel : it->second)
+                    m_Channels.Find(channel)->Leave(client->Id());
+                m_ChannelMemberships.erase(it);
             }
-            else if(connection && connection->IsConnecting())
+        }
+
+        if(OnClientDisconnect)
+            OnClientDisconnect(client);
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::SendFrame_AllClients(const Frame_ptr& frame, const Connection_ptr& ignoredClient)
+    {
+        std::vector<Connection_ptr> disconnected;
+        for(auto& shard : m_Shards)
+        {
+            std::scoped_lock lock(shard->ConnectionsMutex);
+            std::size_t disconnectedBefore = disconnected.size();
+
+            // Iterate through all clients in container
+            for(auto& connection : shard->Connections)
             {
-                // Nothing when connecting
+                // Check client is connected...
+                if(connection->IsConnected())
+                {
+                    // ..it is!
+                    if(connection != ignoredClient)
+                        connection->SendFrame(frame);
+                }
+                else if(connection->IsConnecting())
+                {
+                    // Nothing when connecting
+                }
+                else
+                {
+                    // The client couldn't be contacted, so assume it has disconnected.
+                    // Off you go now, bye bye!
+                    disconnected.emplace_back(connection);
+                }
             }
-            else
+
+            // Remove dead clients after the loop - this way, we don't invalidate the container as we iterated through it.
+            for(std::size_t i = disconnectedBefore; i < disconnected.size(); i++)
             {
-                // The client couldn't be contacted, so assume it has disconnected.
-                if(OnClientDisconnect)
-                    OnClientDisconnect(connection);
+                shard->Connections.Erase(disconnected[i]->Id().Key);
+                Release(*disconnected[i]);
+            }
+        }
 
-                // Off you go now, bye bye!
-                connection.reset();
+        // Outside of the lock so the callback can use the server
+        for(const Connection_ptr& connection : disconnected)
+            OnClientRemoved(connection);
+    }
 
-                // Set this flag to then remove dead clients from container
-                invalidClientExists = true;
-            }
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Dispatch(OwnedMessage_t& msg, Util::PacketArena& arena)
+    {
+        msg.first->OnIncomingProcessed();
+
+        if(msg.second.Header.Flags & PacketFlags::Compressed)
+        {
+            throw std::runtime_error("Packet compression is not supported");
         }
 
-        // Remove dead clients, all in one go - this way, we don't invalidate the container as we iterated through it.
-        if (invalidClientExists)
-            m_Connections.erase(std::remove(m_Connections.begin(), m_Connections.end(), nullptr), m_Connections.end());
+        // Pass to message handler
+        if(OnMessage)
+            OnMessage(msg.first, msg.second);
+
+        //TODO Process some universal packets if their IDs were defined
+
+        if(m_ArenaParser)
+        {
+            IPacket<TPacketID_Receive>* packet = m_ArenaParser(arena, msg.second);
+            if(packet)
+                if(OnArenaPacket)
+                    OnArenaPacket(msg.first, *packet);
+            return;
+        }
+
+        std::unique_ptr<IPacket<TPacketID>> packet = ParsePacket(msg.second);
+        if(packet)
+            if(OnPacket)
+                OnPacket(msg.first, packet);
     }
 
     template<
@@ -336,35 +1306,155 @@ namespace AWEngine::Packet
     >
     std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Update(size_t maximumMessages, bool waitForMessage)
     {
+        ProcessRemoved();
+
         if (waitForMessage)
-            m_MessageInQueue.wait();
+            WaitUntil(Util::CoarseClock::time_point::max());
 
-        if(maximumMessages == 0)
-            return 0;
+        size_t processed = maximumMessages == 0 ? 0 : ProcessMessages(maximumMessages);
 
-        // Process as many messages as you can up to the value specified
-        size_t messageIndex;
-        for(messageIndex = 0; !m_MessageInQueue.empty() && (maximumMessages < 0 || messageIndex < maximumMessages); messageIndex++)
+        // Responses to this batch go out together
+        if(m_Config.DeferredSend && m_Config.AutoFlush)
+            Flush();
+
+        return processed;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Update(Util::CoarseClock::duration budget)
+    {
+        // Coarse clock is not precise enough for budgets of a few milliseconds
+        Util::CoarseClock::time_point deadline = Util::CoarseClock::PreciseNow() + budget;
+
+        ProcessRemoved();
+
+        // Batches keep dispatch workers busy between checks of the clock
+        std::size_t batch     = UpdateBudgetBatch * (m_Dispatcher ? m_Dispatcher->WorkerCount() : 1);
+        std::size_t processed = 0;
+        while(true)
         {
-            // Grab the front message
-            auto msg = m_MessageInQueue.pop_front();
+            std::size_t count = ProcessMessages(batch);
+            processed += count;
+            if(count < batch || Util::CoarseClock::PreciseNow() >= deadline)
+                break;
+        }
+
+        // Responses to this update go out together
+        if(m_Config.DeferredSend && m_Config.AutoFlush)
+            Flush();
+
+        return processed;
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::ProcessRemoved()
+    {
+        // Clients removed by timeout checks of network threads
+        for(auto& shard : m_Shards)
+            shard->Removed.pop_all(m_Removed);
+        for(const Connection_ptr& connection : m_Removed)
+            OnClientRemoved(connection);
+        m_Removed.clear();
+    }
 
-            if(msg.second.Header.Flags & PacketFlags::Compressed)
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::WaitUntil(Util::CoarseClock::time_point deadline)
+    {
+        while(true)
+        {
+            // Read before checking so a message received in between wakes the wait below
+            uint32_t sequence = m_MessageSignal.Sequence();
+            if(HasIncoming())
+                return true;
+            if(!m_MessageSignal.WaitUntil(sequence, deadline))
+                return HasIncoming();
+        }
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    std::size_t PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::ProcessMessages(std::size_t maximumMessages)
+    {
+        // Packets of this batch are not referenced anymore once it is processed, also when a handler throws
+        struct ArenaReset
+        {
+            std::vector<Util::PacketArena>& Arenas;
+            ~ArenaReset()
             {
-                throw std::runtime_error("Packet compression is not supported");
+                for(Util::PacketArena& arena : Arenas)
+                    arena.Reset();
             }
+        } arenaReset{ m_Arenas };
+
+        // Process as many messages as you can up to the value specified
+        size_t messageIndex = 0;
+        for(std::size_t shardOffset = 0; shardOffset < m_Shards.size() && messageIndex < maximumMessages; shardOffset++)
+        {
+            Shard_t& shard = *m_Shards[(m_NextUpdateShard + shardOffset) % m_Shards.size()];
 
-            // Pass to message handler
-            if(OnMessage)
-                OnMessage(msg.first, msg.second);
+            // Take everything received so far under a single lock, leftover of previous `Update` goes first
+            if(shard.MessageBatch.empty())
+                shard.MessageInQueue.pop_all(shard.MessageBatch);
 
-            //TODO Process some universal packets if their IDs were defined
+            for(; !shard.MessageBatch.empty() && messageIndex < maximumMessages; messageIndex++)
+            {
+                // Grab the front message, rest stays in the batch for next `Update` when the limit is reached
+                auto msg = std::move(shard.MessageBatch.front());
+                shard.MessageBatch.pop_front();
 
-            std::unique_ptr<IPacket<TPacketID>> packet = ParsePacket(msg.second);
-            if(packet)
-                if(OnPacket)
-                    OnPacket(msg.first, packet);
+                if(!m_Dispatcher)
+                {
+                    Dispatch(msg, m_Arenas.front());
+                    continue;
+                }
+
+                // All messages of a client in this update form a single task so they stay in order
+                auto [task, inserted] = m_DispatchTaskIndex.try_emplace(msg.first.get(), m_DispatchTasks.size());
+                if(inserted)
+                    m_DispatchTasks.emplace_back();
+                m_DispatchTasks[task->second].emplace_back(std::move(msg));
+            }
         }
+        m_NextUpdateShard = (m_NextUpdateShard + 1) % m_Shards.size();
+
+        if(m_Dispatcher)
+        {
+            // Clients stick to a worker unless it has to be stolen
+            for(DispatchTask_t& task : m_DispatchTasks)
+            {
+                std::size_t worker = std::hash<Util::ConnectionId>()(task.front().first->Id());
+                m_Dispatcher->Push(worker, std::move(task));
+            }
+            m_DispatchTasks.clear();
+            m_DispatchTaskIndex.clear();
+
+            // Tick complete - all handlers are finished when `Update` returns
+            m_Dispatcher->Run();
+        }
+
         return messageIndex;
     }
 
@@ -377,32 +1467,164 @@ namespace AWEngine::Packet
     >
     void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::SendKeepAlive()
     {
-        auto oldestKeepAlive = std::chrono::system_clock::now() - KeepAliveMaxDelay;
+        auto now = Util::CoarseClock::Now();
+
+        // Every client gets reference to the same buffer
+        Frame_ptr ping = Connection_t::MakeFrame(Ping<TPacketID, PacketID_Ping>());
+
+        std::vector<Connection_ptr> disconnected;
+        for(auto& shard : m_Shards)
+        {
+            std::scoped_lock lock(shard->ConnectionsMutex);
+            std::size_t disconnectedBefore = disconnected.size();
+
+            for(auto& connection : shard->Connections)
+            {
+                if(connection->IsConnecting())
+                    continue;
+
+                auto lastReceived = connection->LastReceivedMessageTime();
+                if(!connection->IsConnected() || (m_Config.IdleTimeout.count() != 0 && now - lastReceived >= m_Config.IdleTimeout))
+                {
+                    // The client couldn't be contacted, so assume it has disconnected.
+                    // Off you go now, bye bye!
+                    disconnected.emplace_back(connection);
+                }
+                else if(m_Config.KeepAliveInterval.count() != 0 && now - lastReceived >= m_Config.KeepAliveInterval)
+                {
+                    // Clients which keep sending are alive without asking
+                    connection->SendFrame(ping);
+                }
+            }
+
+            for(std::size_t i = disconnectedBefore; i < disconnected.size(); i++)
+            {
+                shard->Connections.Erase(disconnected[i]->Id().Key);
+                Release(*disconnected[i]);
+            }
+        }
+
+        for(const Connection_ptr& connection : disconnected)
+            OnClientRemoved(connection);
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::TickTimers(Shard_t& shard)
+    {
+        shard.TimerTick.expires_after(m_Config.TimeoutResolution);
+        shard.TimerTick.async_wait(
+            [this, &shard](std::error_code ec)
+            {
+                // Runs on `TimerStrand` (executor of the timer)
+                if(ec)
+                    return;
+
+                auto now = Util::CoarseClock::Refresh();
+                shard.Timers.Advance(TimerTickOf(shard, now), [&shard](Util::SlotMapKey key) { shard.Expired.emplace_back(key); });
+
+                if(!shard.Expired.empty())
+                {
+                    std::scoped_lock lock(shard.ConnectionsMutex);
+                    for(const Util::SlotMapKey& key : shard.Expired)
+                    {
+                        const Connection_ptr* found = shard.Connections.Find(key);
+                        if(!found)
+                            continue; // Already removed
+
+                        Connection_ptr connection = *found;
+                        Util::CoarseClock::time_point next;
+                        if(CheckTimeouts(*connection, now, next))
+                        {
+                            if(next != Util::CoarseClock::time_point::max())
+                                shard.Timers.Schedule(TimerTickOf(shard, next), key);
+                        }
+                        else
+                        {
+                            shard.Connections.Erase(key);
+                            Release(*connection);
+                            shard.Removed.push_back(std::move(connection));
+                        }
+                    }
+                    shard.Expired.clear();
+                }
 
-        bool invalidClientExists = false;
-        for(auto& connection : m_Connections)
+                TickTimers(shard);
+            }
+        );
+    }
+
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    bool PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::CheckTimeouts(Connection_t& connection, Util::CoarseClock::time_point now, Util::CoarseClock::time_point& next)
+    {
+        next = Util::CoarseClock::time_point::max();
+        if(!connection.IsConnected())
+            return false;
+
+        if(m_Config.HandshakeTimeout.count() != 0 && connection.State() != Util::ClientState::Play)
         {
-            // Check client is connected...
-            if(!connection || (!connection->IsConnected() && !connection->IsConnecting()) || (connection->LastKeepAlive() < oldestKeepAlive))
+            auto deadline = connection.CreatedTime() + m_Config.HandshakeTimeout;
+            if(now >= deadline)
             {
-                // The client couldn't be contacted, so assume it has disconnected.
-                if(OnClientDisconnect)
-                    OnClientDisconnect(connection);
+                connection.Disconnect();
+                return false;
+            }
+            next = (std::min)(next, deadline);
+        }
 
-                // Off you go now, bye bye!
-                connection.reset();
+        auto lastReceived = connection.LastReceivedMessageTime();
+        if(m_Config.IdleTimeout.count() != 0)
+        {
+            auto deadline = lastReceived + m_Config.IdleTimeout;
+            if(now >= deadline)
+            {
+                connection.Disconnect();
+                return false;
+            }
+            next = (std::min)(next, deadline);
+        }
 
-                // Set this flag to then remove dead clients from container
-                invalidClientExists = true;
+        if(m_Config.KeepAliveInterval.count() != 0)
+        {
+            // Clients which keep sending are alive without asking
+            auto due = lastReceived + m_Config.KeepAliveInterval;
+            if(now >= due)
+            {
+                connection.Send(Ping<TPacketID, PacketID_Ping>());
+                due = now + m_Config.KeepAliveInterval;
             }
+            next = (std::min)(next, due);
         }
 
-        if(invalidClientExists)
-            m_Connections.erase(std::remove(m_Connections.begin(), m_Connections.end(), nullptr), m_Connections.end());
-        invalidClientExists = false;
+        return true;
+    }
 
-        //TODO Only send KeepAlive to clients with last KeepAlive packet between KeepAliveDelay and KeepAliveMaxDelay
-        Ping<TPacketID, PacketID_Ping> ping = Ping<TPacketID, PacketID_Ping>();
-        Send_AllClients(ping);
+    template<
+        typename TPacketID,
+        typename TPacketID_Receive,
+        TPacketID PacketID_Ping,
+        TPacketID PacketID_Kick,
+        TPacketID PacketID_ServerInfo
+    >
+    void PacketServer<TPacketID, TPacketID_Receive, PacketID_Ping, PacketID_Kick, PacketID_ServerInfo>::Flush()
+    {
+        for(auto& shard : m_Shards)
+        {
+            std::scoped_lock lock(shard->ConnectionsMutex);
+            for(auto& connection : shard->Connections)
+                if(connection->IsConnected())
+                    connection->Flush();
+        }
     }
 }
@@ -11,7 +11,8 @@ namespace AWEngine::Packet
     /// Server expects Pong response with same `Payload` otherwise should terminates the connection.
     /// Client can (and should) use this same class to respond back.
     ///
-    /// The payload is usually current UNIX time but it is not required.
+    /// The payload is creation time of the packet in nanoseconds of `std::chrono::steady_clock`,
+    /// server uses it to measure round-trip time of the connection.
     /// `PacketClient` responds to this packet automatically.
     template<typename TPacketID, TPacketID PacketID>
     class Ping : public IPacket<TPacketID>
@@ -24,7 +25,7 @@ namespace AWEngine::Packet
         }
         /// New instance with current time
         explicit Ping()
-            : Ping(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count())
+            : Ping(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count())
         {
         }
 
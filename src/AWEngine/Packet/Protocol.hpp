@@ -0,0 +1,143 @@
+#pragma once
+#include <AWEngine/Packet/Util/Core_Packet.hpp>
+
+#include <array>
+#include <concepts>
+#include <memory>
+#include <type_traits>
+
+#include "IPacket.hpp"
+#include "PacketBuffer.hpp"
+#include "Util/Connection.hpp"
+#include "Util/PacketArena.hpp"
+
+namespace AWEngine::Packet
+{
+    /// Packet which can be listed in `Protocol`.
+    /// Requires compile-time ID (`static const constexpr TPacketID s_ID`) and constructor reading the packet from `PacketBuffer&`.
+    template<typename T, typename TPacketID>
+    concept ProtocolPacket = std::is_base_of<IPacket<TPacketID>, T>::value &&
+        std::is_constructible<T, PacketBuffer&>::value &&
+        requires { { T::s_ID } -> std::convertible_to<TPacketID>; };
+
+    /// Packets received by one side of the connection.
+    /// Lookup of a packet by ID is a single index into a table generated at compile time,
+    /// the list is checked for duplicate IDs and IDs reserved for packets of the library.
+    ///
+    /// `Protocol<PacketID, MsgA, MsgB>::Parse` (or `ParseInto`) can be used directly as parser of `PacketServer` or `PacketClient`,
+    /// `Dispatch` decodes the packet on stack and passes it to a typed handler without allocation or virtual call.
+    template<typename TPacketID, ProtocolPacket<TPacketID>... TPackets>
+    class Protocol
+    {
+    public:
+        static_assert(std::is_enum<TPacketID>());
+        static_assert(sizeof(TPacketID) == 1);
+
+        typedef std::unique_ptr<IPacket<TPacketID>> Packet_ptr;
+        typedef Packet_ptr (*Decoder_t)(PacketBuffer& in);
+        typedef IPacket<TPacketID>* (*ArenaDecoder_t)(Util::PacketArena& arena, PacketBuffer& in);
+        template<typename THandler>
+        using Handler_t = void (*)(THandler& handler, PacketBuffer& in);
+
+        static const constexpr std::size_t TableSize     = 256;
+        /// IDs from this one up are used by packets of the library (Ping, Init, Kick...)
+        static const constexpr uint8_t     FirstReserved = 0xF0u;
+
+    private:
+        template<typename T>
+        [[nodiscard]] static constexpr uint8_t IdOf() noexcept { return static_cast<uint8_t>(static_cast<TPacketID>(T::s_ID)); }
+
+        [[nodiscard]] static constexpr bool HasUniqueIDs() noexcept
+        {
+            std::array<bool, TableSize> used = {};
+            bool unique = true;
+            ((unique = unique && !used[IdOf<TPackets>()], used[IdOf<TPackets>()] = true), ...);
+            return unique;
+        }
+
+        static_assert(sizeof...(TPackets) > 0, "Protocol without packets");
+        static_assert(HasUniqueIDs(), "Protocol contains multiple packets with the same ID");
+        static_assert(((IdOf<TPackets>() < FirstReserved) && ...), "Packet IDs 0xF0 to 0xFF are reserved for packets of the library");
+
+    private:
+        template<typename T>
+        static Packet_ptr Decode(PacketBuffer& in)
+        {
+            return std::make_unique<T>(in);
+        }
+        template<typename T>
+        static IPacket<TPacketID>* DecodeInto(Util::PacketArena& arena, PacketBuffer& in)
+        {
+            return arena.Create<T>(in);
+        }
+        template<typename THandler, typename T>
+        static void Handle(THandler& handler, PacketBuffer& in)
+        {
+            T packet(in);
+            handler(packet);
+        }
+
+        [[nodiscard]] static constexpr std::array<Decoder_t, TableSize> MakeDecoders() noexcept
+        {
+            std::array<Decoder_t, TableSize> table = {};
+            ((table[IdOf<TPackets>()] = &Decode<TPackets>), ...);
+            return table;
+        }
+        [[nodiscard]] static constexpr std::array<ArenaDecoder_t, TableSize> MakeArenaDecoders() noexcept
+        {
+            std::array<ArenaDecoder_t, TableSize> table = {};
+            ((table[IdOf<TPackets>()] = &DecodeInto<TPackets>), ...);
+            return table;
+        }
+        template<typename THandler>
+        [[nodiscard]] static constexpr std::array<Handler_t<THandler>, TableSize> MakeHandlers() noexcept
+        {
+            std::array<Handler_t<THandler>, TableSize> table = {};
+            ((table[IdOf<TPackets>()] = &Handle<THandler, TPackets>), ...);
+            return table;
+        }
+
+    public:
+        /// Decoder of every packet by its ID, `nullptr` for IDs not in the protocol
+        static constexpr std::array<Decoder_t, TableSize> Decoders = MakeDecoders();
+        /// Decoder into `PacketArena` of every packet by its ID, `nullptr` for IDs not in the protocol
+        static constexpr std::array<ArenaDecoder_t, TableSize> ArenaDecoders = MakeArenaDecoders();
+        /// Typed handler call of every packet by its ID, `nullptr` for IDs not in the protocol
+        template<typename THandler>
+        static constexpr std::array<Handler_t<THandler>, TableSize> Handlers = MakeHandlers<THandler>();
+
+    public:
+        [[nodiscard]] static constexpr std::size_t size() noexcept { return sizeof...(TPackets); }
+        [[nodiscard]] static constexpr bool Contains(uint8_t id) noexcept { return Decoders[id] != nullptr; }
+
+        /// Read the packet, `nullptr` when the ID is not part of the protocol
+        [[nodiscard]] static Packet_ptr Parse(Util::PacketSendInfo& info)
+        {
+            Decoder_t decoder = Decoders[info.Header.ID];
+            return decoder ? decoder(info.Body) : nullptr;
+        }
+
+        /// Read the packet into the arena, `nullptr` when the ID is not part of the protocol.
+        /// Can be used as arena parser of `PacketServer`.
+        [[nodiscard]] static IPacket<TPacketID>* ParseInto(Util::PacketArena& arena, Util::PacketSendInfo& info)
+        {
+            ArenaDecoder_t decoder = ArenaDecoders[info.Header.ID];
+            return decoder ? decoder(arena, info.Body) : nullptr;
+        }
+
+        /// Read the packet and call `handler(packet)` with its real type (e.g. overloaded lambdas or `[](auto& packet)`).
+        /// Returns false when the ID is not part of the protocol.
+        template<typename THandler>
+        static bool Dispatch(Util::PacketSendInfo& info, THandler&& handler)
+        {
+            static_assert((std::is_invocable_v<std::remove_reference_t<THandler>&, TPackets&> && ...), "Handler must accept every packet of the protocol");
+
+            Handler_t<std::remove_reference_t<THandler>> handle = Handlers<std::remove_reference_t<THandler>>[info.Header.ID];
+            if(!handle)
+                return false;
+
+            handle(handler, info.Body);
+            return true;
+        }
+    };
+}
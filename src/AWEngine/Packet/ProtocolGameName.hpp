@@ -32,15 +32,16 @@ namespace AWEngine::Packet
         inline constexpr ProtocolGameName(const std::initializer_list<char>&);
         inline constexpr ProtocolGameName(uint64_t numericValue) noexcept : NumericData(numericValue) {}
 
-        //TODO comparison operators
+    public:
+        [[nodiscard]] inline constexpr bool operator==(const ProtocolGameName& other) const noexcept { return NumericData == other.NumericData; }
     };
     static_assert(sizeof(ProtocolGameName) == ProtocolGameName::CharLength);
 
     inline std::ostream& operator<<(std::ostream& out, ProtocolGameName gameName);
-    inline std::istream& operator>>(std::istream& in,  ProtocolGameName gameName);
+    inline std::istream& operator>>(std::istream& in,  ProtocolGameName& gameName);
 
     inline PacketBuffer& operator<<(PacketBuffer& out, ProtocolGameName gameName);
-    inline PacketBuffer& operator>>(PacketBuffer& in,  ProtocolGameName gameName);
+    inline PacketBuffer& operator>>(PacketBuffer& in,  ProtocolGameName& gameName);
 }
 
 namespace AWEngine::Packet
@@ -69,7 +70,7 @@ namespace AWEngine::Packet
         out.write(gameName.CharData, ProtocolGameName::CharLength);
         return out;
     }
-    inline std::istream& operator>>(std::istream& in,  ProtocolGameName gameName)
+    inline std::istream& operator>>(std::istream& in,  ProtocolGameName& gameName)
     {
         in.read(gameName.CharData, ProtocolGameName::CharLength);
         //TODO Fill unread amount by zeros (like in `PacketBuffer >> ProtocolGameName`)
@@ -81,7 +82,7 @@ namespace AWEngine::Packet
         out.Write(ProtocolGameName::CharLength, reinterpret_cast<uint8_t*>(gameName.CharData));
         return out;
     }
-    inline PacketBuffer& operator>>(PacketBuffer& in,  ProtocolGameName gameName)
+    inline PacketBuffer& operator>>(PacketBuffer& in,  ProtocolGameName& gameName)
     {
         auto readBytes = in.ReadArray(reinterpret_cast<uint8_t*>(gameName.CharData), ProtocolGameName::CharLength);
         if(readBytes != ProtocolGameName::CharLength)
@@ -19,8 +19,12 @@ namespace AWEngine::Packet
     {
         /// Data in the packet are compressed by ________
         Compressed  = 1u << 0u,
-        Unused_Bit1 = 1u << 1u,
-        Unused_Bit2 = 1u << 2u,
+        /// Body is part of a bigger body which did not fit into a single packet.
+        /// See `Util/Fragment.hpp` for format.
+        Fragment    = 1u << 1u,
+        /// Packet arrived over the unreliable side channel, or (`ServerInfo` over TCP) offer of the channel.
+        /// See `Util/Datagram.hpp`.
+        Datagram    = 1u << 2u,
         Unused_Bit3 = 1u << 3u,
         Unused_Bit4 = 1u << 4u,
         Unused_Bit5 = 1u << 5u,
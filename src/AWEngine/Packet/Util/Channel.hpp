@@ -0,0 +1,61 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "ConnectionId.hpp"
+#include "SlotMap.hpp"
+
+namespace AWEngine::Packet::Util
+{
+    /// Handle of a channel created by `PacketServer::CreateChannel`
+    typedef SlotMapKey ChannelId;
+
+    /// Set of clients receiving the same packets (zone, party, spectators...).
+    /// Members are stored densely for fast fan-out, join and leave are O(1).
+    class Channel
+    {
+    private:
+        std::vector<ConnectionId>                  m_Members  = {};
+        /// Position of member in `m_Members`
+        std::unordered_map<ConnectionId, uint32_t> m_Position = {};
+
+    public:
+        [[nodiscard]] inline std::size_t                    size()    const noexcept { return m_Members.size(); }
+        [[nodiscard]] inline bool                           empty()   const noexcept { return m_Members.empty(); }
+        [[nodiscard]] inline std::span<const ConnectionId>  Members() const noexcept { return m_Members; }
+        [[nodiscard]] inline bool Contains(const ConnectionId& id) const { return m_Position.contains(id); }
+
+    public:
+        /// Returns false when already a member
+        inline bool Join(const ConnectionId& id)
+        {
+            if(!m_Position.emplace(id, static_cast<uint32_t>(m_Members.size())).second)
+                return false;
+
+            m_Members.emplace_back(id);
+            return true;
+        }
+        /// Returns false when not a member
+        inline bool Leave(const ConnectionId& id)
+        {
+            auto it = m_Position.find(id);
+            if(it == m_Position.end())
+                return false;
+
+            // Last member takes place of the removed one
+            uint32_t position = it->second;
+            m_Position.erase(it);
+            if(position != m_Members.size() - 1)
+            {
+                m_Members[position] = m_Members.back();
+                m_Position[m_Members[position]] = position;
+            }
+            m_Members.pop_back();
+            return true;
+        }
+    };
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <atomic>
+#include <chrono>
+
+#include <asio.hpp>
+
+namespace AWEngine::Packet::Util
+{
+    /// Monotonic clock read from a cached value.
+    /// The value is refreshed by a timer of every network thread (see `Run`) and written at most once per `DefaultResolution`
+    /// so reading it costs a single relaxed atomic load and the cache line is rarely invalidated.
+    /// The value may be up to about twice the resolution old.
+    /// Use for timestamps on hot paths (last sent/received message, timeouts), not for measuring short durations.
+    /// Time points are compatible with `std::chrono::steady_clock`.
+    class CoarseClock
+    {
+    public:
+        typedef std::chrono::steady_clock::duration   duration;
+        typedef duration::rep                         rep;
+        typedef duration::period                      period;
+        typedef std::chrono::steady_clock::time_point time_point;
+        static const constexpr bool is_steady = true;
+
+        static const constexpr std::chrono::milliseconds DefaultResolution = std::chrono::milliseconds(10);
+
+    public:
+        CoarseClock() = delete;
+
+    private:
+        static inline std::atomic<rep> s_Now = 0;
+        static_assert(std::atomic<rep>::is_always_lock_free);
+
+    public:
+        /// Cached time.
+        /// Refreshed on the first call if no network thread is running yet.
+        [[nodiscard]] static inline time_point Now() noexcept
+        {
+            rep now = s_Now.load(std::memory_order_relaxed);
+            if(now == 0)
+                return Refresh();
+            return time_point(duration(now));
+        }
+        /// Current time from `std::chrono::steady_clock`.
+        /// Only for measuring round-trip time, everything else should use `Now`.
+        [[nodiscard]] static inline time_point PreciseNow() noexcept
+        {
+            return std::chrono::steady_clock::now();
+        }
+
+        /// Updates the cached time when it is at least `resolution` old, returns the current time.
+        /// Safe to call from multiple threads, the cached time never goes back.
+        static inline time_point Refresh(duration resolution = DefaultResolution) noexcept
+        {
+            rep now      = std::chrono::steady_clock::now().time_since_epoch().count();
+            rep previous = s_Now.load(std::memory_order_relaxed);
+            while(now - previous >= resolution.count() && !s_Now.compare_exchange_weak(previous, now, std::memory_order_relaxed))
+            {
+            }
+            return time_point(duration(now));
+        }
+
+    public:
+        /// Replacement of `context.run()` which keeps the clock fresh.
+        /// Returns when the context is stopped.
+        static inline void Run(asio::io_context& context, duration resolution = DefaultResolution)
+        {
+            // Refreshed by the timer only, not after every handler - a busy thread would write on every wake-up
+            asio::steady_timer timer(context);
+            std::function<void(std::error_code)> tick = [&](std::error_code ec)
+            {
+                if(ec)
+                    return;
+                Refresh(resolution);
+                timer.expires_after(resolution);
+                timer.async_wait(tick);
+            };
+            tick({});
+
+            context.run();
+
+            timer.cancel();
+        }
+    };
+}
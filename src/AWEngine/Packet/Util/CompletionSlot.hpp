@@ -0,0 +1,115 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <asio.hpp>
+
+namespace AWEngine::Packet::Util
+{
+    template<typename TSignature>
+    class CompletionSlot;
+
+    /// Completion handler of a single pending asynchronous operation (e.g. `co_await connection->Receive()`).
+    /// Handlers up to `InlineSize` bytes (e.g. those of `asio::use_awaitable`) are stored without allocation,
+    /// frames of `asio::awaitable` coroutines are recycled by asio so a session awaiting packets in a loop does not allocate per packet.
+    /// The handler is always invoked through its associated executor, never from `Complete` itself.
+    /// Not thread-safe, the owner serializes access (strand or mutex).
+    template<typename... TArgs>
+    class CompletionSlot<void(TArgs...)> : public ::AWEngine::Packet::NoCopyOrMove
+    {
+    public:
+        static const constexpr std::size_t InlineSize = 128;
+
+    public:
+        CompletionSlot() = default;
+        ~CompletionSlot()
+        {
+            Reset();
+        }
+
+    private:
+        struct Base
+        {
+            virtual ~Base() = default;
+            /// Post the handler, `this` is destroyed by the caller afterwards
+            virtual void Post(TArgs... args) = 0;
+        };
+
+        template<typename THandler, typename TExecutor>
+        struct Impl final : public Base
+        {
+            Impl(THandler&& handler, const TExecutor& executor)
+                : Handler(std::move(handler)),
+                  Work(asio::make_work_guard(executor))
+            {
+            }
+
+            THandler                             Handler;
+            /// Keeps the context of the handler running while the operation is pending
+            asio::executor_work_guard<TExecutor> Work;
+
+            void Post(TArgs... args) override
+            {
+                asio::post(
+                    Work.get_executor(),
+                    [handler = std::move(Handler), ...args = std::move(args)]() mutable
+                    {
+                        std::move(handler)(std::move(args)...);
+                    }
+                );
+            }
+        };
+
+    private:
+        alignas(std::max_align_t) std::byte m_Storage[InlineSize];
+        Base* m_Handler = nullptr;
+
+    public:
+        [[nodiscard]] inline bool empty() const noexcept { return m_Handler == nullptr; }
+
+    public:
+        /// Store handler of a new operation, `fallbackExecutor` is used when the handler has no associated executor.
+        /// Only when empty.
+        template<typename THandler, typename TExecutor>
+        inline void Set(THandler&& handler, const TExecutor& fallbackExecutor)
+        {
+            typedef std::decay_t<THandler>                                  Handler_t;
+            typedef asio::associated_executor_t<Handler_t, TExecutor>       Executor_t;
+            typedef Impl<Handler_t, Executor_t>                             Impl_t;
+
+            Executor_t executor = asio::get_associated_executor(handler, fallbackExecutor);
+            if constexpr(sizeof(Impl_t) <= InlineSize && alignof(Impl_t) <= alignof(std::max_align_t))
+                m_Handler = new(m_Storage) Impl_t(std::move(handler), executor);
+            else
+                m_Handler = new Impl_t(std::move(handler), executor);
+        }
+
+        /// Finish the operation, does nothing when no operation is pending
+        inline void Complete(TArgs... args)
+        {
+            if(!m_Handler)
+                return;
+
+            m_Handler->Post(std::move(args)...);
+            Reset();
+        }
+
+    private:
+        inline void Reset() noexcept
+        {
+            if(!m_Handler)
+                return;
+
+            if(static_cast<void*>(m_Handler) == static_cast<void*>(m_Storage))
+                m_Handler->~Base();
+            else
+                delete m_Handler;
+            m_Handler = nullptr;
+        }
+    };
+}
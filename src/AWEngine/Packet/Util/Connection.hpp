@@ -3,8 +3,24 @@
 
 #include <asio.hpp>
 
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "AWEngine/Packet/IPacket.hpp"
 #include "ThreadSafeQueue.hpp"
+#include "SocketOptions.hpp"
+#include "LatencyHistogram.hpp"
+#include "CoarseClock.hpp"
+#include "TrafficStats.hpp"
+#include "Fragment.hpp"
+#include "ConnectionId.hpp"
+#include "CompletionSlot.hpp"
+#include "ReceiveBufferPool.hpp"
+#include "Datagram.hpp"
 #include "AWEngine/Packet/PacketBuffer.hpp"
 #include "AWEngine/Packet/Ping.hpp"
 #include "AWEngine/Packet/ToServer/Login/Init.hpp"
@@ -22,10 +38,56 @@ namespace AWEngine::Packet::Util
         Play
     };
 
+    /// Header and body of a packet.
+    /// `Header` is in local endian, body of a frame (see `NewFrame`) starts with space for the header in network format
+    /// so the whole packet is written to (and read from) the socket as one contiguous region.
     struct PacketSendInfo
     {
         PacketHeader<uint8_t> Header;
         PacketBuffer          Body;
+
+    public:
+        static const constexpr uint32_t HeaderSize = sizeof(PacketHeader<uint8_t>);
+
+        /// Empty packet with space for the header reserved in front of the body.
+        /// `reserve` bytes of the body are allocated together with the header.
+        [[nodiscard]] static inline PacketSendInfo NewFrame(uint8_t id, PacketFlags flags = {}, uint32_t reserve = 0)
+        {
+            PacketSendInfo info = {};
+            info.Header.ID    = id;
+            info.Header.Flags = flags;
+            info.Header.Size  = 0;
+            if(reserve > 0)
+                info.Body.reserve(HeaderSize + reserve);
+            info.Body.ReservePrefix(HeaderSize);
+            return info;
+        }
+
+        /// Set size of the header from the body and write the header into the space in front of the body
+        inline void SealFrame()
+        {
+            if(Body.PrefixSize() != HeaderSize)
+                throw std::runtime_error("Packet body has no space for header");
+
+            Header.Size = static_cast<uint16_t>(Body.size());
+
+            uint8_t* prefix = Body.Prefix();
+            prefix[0] = Header.ID;
+            prefix[1] = static_cast<uint8_t>(Header.Flags);
+            uint16_t size = htobe16(Header.Size); // Swap from local to network endian
+            std::memcpy(prefix + 2, &size, sizeof(size));
+        }
+
+        /// Read header written by `SealFrame` from space in front of the body
+        inline void ParseHeader()
+        {
+            const uint8_t* prefix = Body.Prefix();
+            Header.ID    = prefix[0];
+            Header.Flags = static_cast<PacketFlags>(prefix[1]);
+            uint16_t size;
+            std::memcpy(&size, prefix + 2, sizeof(size));
+            Header.Size  = be16toh(size); // Swap from network to local endian
+        }
     };
 
     template<
@@ -38,6 +100,32 @@ namespace AWEngine::Packet::Util
     public:
         typedef std::shared_ptr<Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>> Connection_ptr;
         typedef std::pair<Connection_ptr, PacketSendInfo>                                   OwnedMessage_t;
+        /// Serialized packet, immutable so it can be queued to multiple connections
+        typedef std::shared_ptr<const PacketSendInfo>                                       Frame_ptr;
+
+        /// Data of the server needed to complete handshakes on network threads, shared by all connections of the server.
+        /// Status requests are answered and closed without ever reaching the incoming queue.
+        struct ServerHandshake
+        {
+            ProtocolGameName    GameName    = {};
+            ProtocolGameVersion GameVersion = 0;
+            /// Response to `Init` with `NextInitStep::ServerInfo`, may be replaced at any time
+            std::atomic<Frame_ptr> ServerInfo = nullptr;
+            /// Sent to clients of a different game or version trying to join before they are disconnected
+            Frame_ptr Incompatible = nullptr;
+            /// Sent to clients joining when `AdmitPlayer` refuses them before they are disconnected
+            Frame_ptr ServerFull = nullptr;
+            /// Called from the network thread when a compatible client joins, reserves its place - false when the server is full
+            std::function<bool()> AdmitPlayer = {};
+            /// Returns the place reserved by `AdmitPlayer` of a connection the server already removed
+            std::function<void()> ReleasePlayer = {};
+            /// Called from the network thread once the status response was sent and the connection closed
+            std::function<void(const Connection_ptr&)> OnStatusServed = {};
+#ifdef AWE_PACKET_COROUTINE
+            /// Called from the network thread when a client of a connection in session mode joined, see `SetSessionMode`
+            std::function<void(const Connection_ptr&)> OnJoined = {};
+#endif
+        };
 
     public:
         /// Constructor: Specify Owner, connect to context, transfer the socket
@@ -55,7 +143,11 @@ namespace AWEngine::Packet::Util
         {
         }
 
-        ~Connection() = default;
+        ~Connection()
+        {
+            if(m_ReceivePool)
+                m_ReceivePool->Release(m_ReceiveBufferSlot);
+        }
 
     public:
         enum class ConnectionStatus : uint8_t
@@ -65,29 +157,39 @@ namespace AWEngine::Packet::Util
             Connected
         };
 
-        typedef std::chrono::system_clock::time_point TimePoint_t;
+        typedef CoarseClock::time_point TimePoint_t;
 
     private:
         const PacketDirection m_Direction;
-        bool                  m_IsConnecting = false;
-        ClientState           m_ClientState  = ClientState::Unknown;
+        bool                     m_IsConnecting = false;
+        /// Written by the strand, read by timeout checks of the server
+        std::atomic<ClientState> m_ClientState  = ClientState::Unknown;
 
         std::unique_ptr<IPacket<TPacketID>> m_InitPacket = nullptr;
 
-        uint64_t    m_LastKeepAliveValue      = 0;
-        TimePoint_t m_LastKeepAlive           = std::chrono::system_clock::now();
-        TimePoint_t m_LastReceivedMessageTime = m_LastKeepAlive;
-        TimePoint_t m_LastSentMessageTime     = m_LastKeepAlive;
+        const TimePoint_t        m_CreatedTime             = CoarseClock::Now();
+        /// Payload of the last KeepAlive sent by the server, only accessed from the strand
+        uint64_t                 m_LastKeepAliveValue      = 0;
+        TimePoint_t              m_LastKeepAlive           = m_CreatedTime;
+        /// Written by the strand, read by timeout checks of the server
+        std::atomic<TimePoint_t> m_LastReceivedMessageTime = m_CreatedTime;
+        TimePoint_t              m_LastSentMessageTime     = m_CreatedTime;
 
         // Each connection has a unique socket to a remote
         asio::ip::tcp::socket m_Socket;
 
         // This context is shared with the whole asio instance
         asio::io_context& m_IoContext;
-
+        // Handlers of this connection never run concurrently even when the context is run by multiple threads
+        asio::strand<asio::io_context::executor_type> m_Strand = asio::make_strand(m_IoContext);
+    public:
+        /// All work of the connection is executed through this strand
+        [[nodiscard]] inline const asio::strand<asio::io_context::executor_type>& Strand() const noexcept { return m_Strand; }
+    private:
         // This queue holds all messages to be sent to the remote side
         // of this connection
-        ThreadSafeQueue<PacketSendInfo> m_MessagesOut;
+        // Only accessed from the strand
+        std::deque<Frame_ptr> m_MessagesOut;
 
         // This references the incoming queue of the parent object
         ThreadSafeQueue<OwnedMessage_t>& m_MessagesIn;
@@ -99,147 +201,888 @@ namespace AWEngine::Packet::Util
         [[nodiscard]] inline asio::ip::tcp::endpoint RemoteEndpoint() const noexcept { return IsConnected() ? m_Socket.remote_endpoint() : asio::ip::tcp::endpoint{}; }
         [[nodiscard]] inline asio::ip::tcp::endpoint LocalEndpoint()  const noexcept { return IsConnected() ? m_Socket.local_endpoint() : asio::ip::tcp::endpoint{}; }
     public:
+        [[nodiscard]] inline ClientState        State()                   const noexcept { return m_ClientState.load(std::memory_order_relaxed); }
+        [[nodiscard]] inline const TimePoint_t& CreatedTime()             const noexcept { return m_CreatedTime; }
         [[nodiscard]] inline const TimePoint_t& LastKeepAlive()           const noexcept { return m_LastKeepAlive; }
-        [[nodiscard]] inline const TimePoint_t& LastReceivedMessageTime() const noexcept { return m_LastReceivedMessageTime; }
+        [[nodiscard]] inline TimePoint_t        LastReceivedMessageTime() const noexcept { return m_LastReceivedMessageTime.load(std::memory_order_relaxed); }
         [[nodiscard]] inline const TimePoint_t& LastSentMessageTime()     const noexcept { return m_LastSentMessageTime; }
 
+    private:
+        /// Handle in the server which owns the connection
+        ConnectionId m_Id = {};
+    public:
+        /// Null for connections owned by client and until the server accepts the connection.
+        [[nodiscard]] inline const ConnectionId& Id()         const noexcept { return m_Id; }
+        /// Index of `ServerShard` which owns the connection
+        [[nodiscard]] inline std::size_t         ShardIndex() const noexcept { return m_Id.Shard; }
+        /// Only for connections owned by server, set before the connection is started.
+        inline void SetId(const ConnectionId& id) noexcept { m_Id = id; }
+
+    private:
+        /// Only for connections owned by server
+        const ServerHandshake* m_Handshake     = nullptr;
+        /// Close the connection once everything queued is written, set by `Finish`
+        bool                   m_CloseWhenSent = false;
+        enum class PlayerPlace : uint8_t
+        {
+            None = 0,
+            Taken,
+            Released
+        };
+        /// Place reserved by `ServerHandshake::AdmitPlayer`, taken by the strand and released by the server once
+        std::atomic<PlayerPlace> m_PlayerPlace = PlayerPlace::None;
+    public:
+        /// Must outlive the connection, set before the connection is started.
+        inline void SetHandshake(const ServerHandshake* handshake) noexcept { m_Handshake = handshake; }
+        /// Called by the server after it removed the connection, true (only once) when the connection held a place of a player.
+        /// A place taken later is returned through `ServerHandshake::ReleasePlayer` instead.
+        [[nodiscard]] inline bool ReleasePlayer() noexcept { return m_PlayerPlace.exchange(PlayerPlace::Released, std::memory_order_acq_rel) == PlayerPlace::Taken; }
+    private:
+        /// Send the last frame, stop reading and close the connection when it is written
+        void Finish(Frame_ptr frame);
+        /// Handle `Init` and packets before it, false when the message is consumed by the handshake and must not reach the owner
+        bool Handshake(PacketSendInfo& msg);
+
+    // Round-trip time measured from KeepAlive packets sent by the server.
+    private:
+        RttStats          m_Rtt           = {};
+        /// Server-wide histogram, every sample is recorded there too
+        LatencyHistogram* m_ServerLatency = nullptr;
+    public:
+        [[nodiscard]] inline const RttStats& Rtt() const noexcept { return m_Rtt; }
+        /// Must outlive the connection.
+        inline void SetServerLatency(LatencyHistogram* histogram) noexcept { m_ServerLatency = histogram; }
+
     public:
         void ConnectToClient();
-        void ConnectToServer(const asio::ip::tcp::resolver::results_type& endpoints, std::unique_ptr<IPacket<TPacketID>> initPacket);
+        void ConnectToServer(const asio::ip::tcp::resolver::results_type& endpoints, std::unique_ptr<IPacket<TPacketID>> initPacket, const SocketOptions& socketOptions = {});
 
         void Disconnect();
+    private:
+        /// ASYNC - Try endpoints from `next` until one accepts, the socket is opened and configured by `ApplyPreConnectSocketOptions` before every attempt
+        void ConnectToEndpoint(asio::ip::tcp::resolver::results_type endpoints, asio::ip::tcp::resolver::results_type::const_iterator next, SocketOptions socketOptions);
 
     public:
+        /// Serialize `packet` once, the result can be sent to any number of connections using `SendFrame`.
+        /// Bodies bigger than `PacketBuffer::MaxSize` are not sealed, `SendFrame` sends them in fragments.
+        [[nodiscard]] static Frame_ptr MakeFrame(const Packet::IPacket<TPacketID>& packet);
+        /// Serialize packet of type known at compile time, `Write` is called directly (may be inlined) and the frame is presized by `s_MaxSize`.
+        template<StaticPacketConcept<TPacketID> T>
+        [[nodiscard]] static Frame_ptr MakeFrame(const T& packet);
+
         inline void Send(const Packet::IPacket<TPacketID>& packet);
+        /// Send packet of type known at compile time, see `StaticPacketConcept`
+        template<StaticPacketConcept<TPacketID> T>
+        inline void Send(const T& packet)
+        {
+            if(!IsConnected())
+                throw std::runtime_error("Not Connected - Send(packet)");
+
+            SendFrame(MakeFrame(packet));
+        }
         inline void Send(const std::unique_ptr<Packet::IPacket<TPacketID>>& packet)
         {
             if(packet)
                 Send(*packet);
         }
+        /// Send packet serialized by `MakeFrame`
+        void SendFrame(Frame_ptr frame);
+
+    private:
+        /// When enabled, `Send` only stages the packet and `Flush` writes all staged packets at once.
+        bool m_DeferredSend = false;
+        /// Packets waiting for `Flush`
+        std::vector<Frame_ptr> m_Staged = {};
+        /// Guards `m_Staged`
+        std::mutex m_StagedMutex = {};
+    public:
+        [[nodiscard]] inline bool IsDeferredSend() const noexcept { return m_DeferredSend; }
+        /// Only change before the connection starts sending packets.
+        inline void SetDeferredSend(bool deferred) noexcept { m_DeferredSend = deferred; }
+        /// Write all packets staged by `Send` in deferred mode.
+        /// Does nothing when nothing was staged.
+        void Flush();
+
+    private:
+        /// Whether a write is in progress
+        bool m_Writing = false;
+        /// ASYNC - Start writing next message (or fragment) if there is any and nothing is being written
+        void WriteNext();
+        /// Count everything not written yet as dropped and forget it
+        void DropOutgoing();
+        /// ASYNC - Prime context to write header and body of a message in one contiguous write
+        void WriteFrame();
+        /// Number of messages (from the front of `m_MessagesOut`) being written by `WriteBatch`
+        std::size_t m_BatchSize = 0;
+        /// Reused buffer sequence of `WriteBatch`, one frame per message
+        std::vector<asio::const_buffer> m_BatchBuffers = {};
+        /// ASYNC - Prime context to write all queued messages using single gathered write
+        void WriteBatch();
+
+    // Zero-copy sends (MSG_ZEROCOPY, Linux) - the kernel sends straight from the frame instead of copying it,
+    // the frame stays referenced until the kernel reports on the error queue of the socket that it does not need it anymore.
+    // Pays off for big frames shared by many clients (world chunks, replays), small frames are cheaper to copy.
+    private:
+        std::size_t m_ZeroCopyThreshold = 0;
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        struct PinnedFrame
+        {
+            /// Sequence number of the last send call of the frame
+            uint32_t  LastCall;
+            Frame_ptr Frame;
+        };
+        /// Sequence number of the next zero-copy send call, the kernel counts them the same way
+        uint32_t                m_ZeroCopyCall     = 0;
+        /// Bytes of the front message already sent
+        std::size_t             m_ZeroCopyOffset   = 0;
+        /// Frames the kernel may still read from, oldest first
+        std::deque<PinnedFrame> m_Pinned           = {};
+        bool                    m_WaitingErrorQueue = false;
+#endif
+    public:
+        /// Frames of at least `bytes` (including header) are sent without copying, 0 = disabled.
+        /// Returns false when not supported (not Linux or refused by the socket).
+        /// Only for connected socket before it is used.
+        bool SetZeroCopyThreshold(std::size_t bytes);
+        [[nodiscard]] inline std::size_t ZeroCopyThreshold() const noexcept { return m_ZeroCopyThreshold; }
+    private:
+        [[nodiscard]] inline bool IsZeroCopy(const Frame_ptr& frame) const noexcept { return m_ZeroCopyThreshold != 0 && frame->Body.Frame().size() >= m_ZeroCopyThreshold; }
+        /// ASYNC - Send zero-copy messages from the front of the queue
+        void WriteZeroCopy();
+        /// ASYNC - Collect completions until no frame is pinned
+        void WaitZeroCopyCompletion();
+        /// Release frames the kernel reported as sent
+        void CollectZeroCopyCompletions();
+
+#ifdef AWE_PACKET_COROUTINE
+    // Session mode - packets received after the join are not pushed to the incoming queue,
+    // the connection reads only while a coroutine waits in `Receive` (e.g. `PacketSendInfo msg = co_await connection->Receive();`).
+    // Only one `Receive` and one `Send` with completion token may be pending at a time, others fail with `asio::error::in_progress`.
+    // Pending operations fail with the error which closed the connection.
+    private:
+        bool                                                   m_SessionMode = false;
+        CompletionSlot<void(asio::error_code, PacketSendInfo)> m_ReceiveSlot = {};
+        CompletionSlot<void(asio::error_code)>                 m_SendSlot    = {};
+        /// Frame (or body of fragmented packet) whose write completes `m_SendSlot`
+        const void*                                            m_SendWaiter  = nullptr;
+    public:
+        [[nodiscard]] inline bool IsSessionMode() const noexcept { return m_SessionMode; }
+        /// Only for connections owned by server, set before the connection is started.
+        /// The `Init` packet is consumed, `ServerHandshake::OnJoined` is called instead.
+        inline void SetSessionMode(bool session) noexcept { m_SessionMode = session; }
+
+        /// Wait for next packet of the client (KeepAlive is answered internally and never returned).
+        /// Completion signature `void(asio::error_code, PacketSendInfo)`, the packet is not parsed.
+        template<typename TToken = asio::use_awaitable_t<>>
+        inline auto Receive(TToken token = {})
+        {
+            return asio::async_initiate<TToken, void(asio::error_code, PacketSendInfo)>(
+                [self = this->shared_from_this()](auto handler)
+                {
+                    Connection* connection = self.get();
+                    asio::dispatch(connection->m_Strand, [self = std::move(self), handler = std::move(handler)]() mutable { self->StartReceive(std::move(handler)); });
+                },
+                token
+            );
+        }
+        /// Send packet and wait until it is written to the socket, completion signature `void(asio::error_code)`.
+        /// Not affected by `DeferredSend`, e.g. `co_await connection->Send(packet, asio::use_awaitable);`.
+        template<typename TPacket, typename TToken>
+        inline auto Send(const TPacket& packet, TToken&& token)
+        {
+            return asio::async_initiate<TToken, void(asio::error_code)>(
+                [self = this->shared_from_this()](auto handler, Frame_ptr frame)
+                {
+                    Connection* connection = self.get();
+                    asio::dispatch(connection->m_Strand, [self = std::move(self), handler = std::move(handler), frame = std::move(frame)]() mutable { self->StartSend(std::move(handler), std::move(frame)); });
+                },
+                token,
+                MakeFrame(packet)
+            );
+        }
+    private:
+        template<typename THandler>
+        void StartReceive(THandler&& handler);
+        template<typename THandler>
+        void StartSend(THandler&& handler, Frame_ptr frame);
+#endif
+    private:
+        /// Fail operations waiting in `Receive` and `Send` (session mode), the connection was closed
+        inline void FailPending([[maybe_unused]] const asio::error_code& ec)
+        {
+#ifdef AWE_PACKET_COROUTINE
+            m_ReceiveSlot.Complete(ec, PacketSendInfo{});
+            m_SendSlot.Complete(ec);
+            m_SendWaiter = nullptr;
+#endif
+        }
+        /// Frame was written to the socket
+        inline void OnFrameWritten([[maybe_unused]] const PacketSendInfo* frame)
+        {
+#ifdef AWE_PACKET_COROUTINE
+            if(frame == m_SendWaiter)
+            {
+                m_SendWaiter = nullptr;
+                m_SendSlot.Complete(asio::error_code{});
+            }
+#endif
+        }
 
+    // Packets with body bigger than `PacketBuffer::MaxSize` are sent in fragments, see `PacketFlags::Fragment`.
+    // Fragments interleave with other packets so those are delayed by at most one fragment.
+    private:
+        /// Size of body of a single fragment (including fragment header)
+        std::size_t                                  m_FragmentSize      = 16 * 1024;
+        /// Limit of all bodies being reassembled at the same time
+        std::size_t                                  m_MaxReassemblySize = 64 * 1024 * 1024;
+        std::size_t                                  m_ReassemblySize    = 0;
+        /// Only accessed from the strand
+        uint16_t                                     m_NextStreamID      = 0;
+        /// Streams being sent, round-robin, only accessed from the strand
+        std::deque<OutgoingStream>                   m_StreamsOut        = {};
+        /// Whether the next write should prefer a fragment over a message
+        bool                                         m_FragmentTurn      = false;
+        /// Streams being received, only accessed from the strand
+        std::unordered_map<uint16_t, IncomingStream> m_StreamsIn         = {};
+        /// When set, fragments are passed to it as they arrive instead of being reassembled
+        std::function<void(const StreamChunk&)>      m_OnStreamChunk     = {};
+    private:
+        /// Queue frame to be written, starts a stream when too big for a single frame - from the strand
+        void QueueFrame(Frame_ptr frame);
+    public:
+        /// Must be bigger than fragment header and not bigger than `PacketBuffer::MaxSize`.
+        inline void SetFragmentSize(std::size_t size)
+        {
+            if(size <= FragmentFirstHeaderSize || size > PacketBuffer::MaxSize)
+                throw std::runtime_error("Invalid fragment size");
+            m_FragmentSize = size;
+        }
+        /// Remote side is disconnected when it tries to send more.
+        inline void SetMaxReassemblySize(std::size_t size) noexcept { m_MaxReassemblySize = size; }
+        /// Called from the network thread for every received fragment.
+        /// Only change before the connection is started.
+        inline void SetStreamChunkHandler(std::function<void(const StreamChunk&)> handler) noexcept { m_OnStreamChunk = std::move(handler); }
     private:
-        /// ASYNC - Prime context to write a message header
-        void WriteHeader();
-        /// ASYNC - Prime context to write a message body
-        void WriteBody();
+        /// Cut next fragment from the front stream
+        Frame_ptr NextFragment();
+        /// Process received fragment in `m_WipInMessage`.
+        /// Returns true when a whole body was reassembled into `m_WipInMessage`.
+        bool ReceiveFragment();
 
     private:
         /// Message in middle of receiving
         PacketSendInfo m_WipInMessage = {};
     private:
-        /// ASYNC - Prime context ready to read a message header
+        /// ASYNC - Prime context ready to read a message header (into space in front of the body)
         void ReadHeader();
-        /// ASYNC - Prime context ready to read a message body
+        /// ASYNC - Prime context ready to read a message body (right behind the header)
         void ReadBody();
 
         /// Once a full message is received, add it to the incoming queue
         void AddToIncomingMessageQueue();
 
-    // Information about number of processed packets.
+    // Reading through a slot of `ReceiveBufferPool` - whatever the socket has is read at once and packets are cut out of it.
+    private:
+        std::shared_ptr<ReceiveBufferPool> m_ReceivePool       = nullptr;
+        std::size_t                        m_ReceiveBufferSlot = 0;
+        /// Received bytes not processed yet are `[m_ReceiveBegin, m_ReceiveEnd)` of the slot
+        std::size_t                        m_ReceiveBegin      = 0;
+        std::size_t                        m_ReceiveEnd        = 0;
+        /// `ReadBuffered` is on the stack, next packet is cut by its loop instead of recursion
+        bool                               m_CuttingPackets    = false;
+        bool                               m_NextPacketWanted  = false;
+    public:
+        /// Read through `slot` of `pool`, the slot is returned when the connection is destroyed.
+        /// Only before the connection is started.
+        inline void SetReceiveBuffer(std::shared_ptr<ReceiveBufferPool> pool, std::size_t slot) noexcept
+        {
+            m_ReceivePool = std::move(pool);
+            m_ReceiveBufferSlot = slot;
+        }
+        [[nodiscard]] inline bool HasReceiveBuffer() const noexcept { return m_ReceivePool != nullptr; }
+    private:
+        /// Cut next packet out of the receive buffer or read more when there is no whole packet (`ReadHeader` with receive buffer)
+        void ReadBuffered();
+        /// ASYNC - Read as much as fits into the rest of the receive buffer
+        void ReadSome();
+
+    // Unreliable side channel, see `Util/Datagram.hpp`.
+    // Packets listed in `DatagramOptions::Unreliable` are sent as datagrams once both sides know the channel works.
+    private:
+        static const constexpr std::chrono::milliseconds DatagramHelloInterval = std::chrono::milliseconds(200);
+        /// Client gives up (keeps using TCP) when the server does not answer any of them, e.g. UDP is blocked
+        static const constexpr std::size_t               DatagramHelloAttempts = 25;
+
+        DatagramOptions                    m_DatagramOptions   = {};
+        std::shared_ptr<DatagramSocket>    m_Datagrams         = nullptr;
+        /// Identification of the connection in every datagram, server generates the token
+        DatagramHeader                     m_DatagramHeader    = {};
+        /// Server - token of `m_DatagramHeader` for checks outside of the strand, 0 until offered
+        std::atomic<uint64_t>              m_DatagramToken     = 0;
+        /// Address of the other side, fixed once `m_DatagramReady` is set
+        asio::ip::udp::endpoint            m_DatagramPeer      = {};
+        /// Both sides know the channel works, read by any sending thread
+        std::atomic<bool>                  m_DatagramReady     = false;
+        std::atomic<uint32_t>              m_DatagramSequence  = 0;
+        /// Only accessed from the strand
+        DatagramSequenceFilter             m_DatagramFilter    = {};
+        // Client only
+        std::optional<asio::steady_timer>  m_DatagramHelloTimer = std::nullopt;
+        std::size_t                        m_DatagramHellos     = 0;
+        std::vector<uint8_t>               m_DatagramBuffer     = {};
+        asio::ip::udp::endpoint            m_DatagramSender     = {};
+    public:
+        /// Client: accept the side channel when the server offers it.
+        /// Server: use the socket of the server, offered after the client joins.
+        /// Set before the connection is started.
+        inline void SetDatagramOptions(const DatagramOptions& options, std::shared_ptr<DatagramSocket> serverSocket = nullptr)
+        {
+            m_DatagramOptions = options;
+            m_Datagrams       = std::move(serverSocket);
+        }
+        /// Unreliable packets go over the side channel
+        [[nodiscard]] inline bool IsDatagramReady() const noexcept { return m_DatagramReady.load(std::memory_order_acquire); }
+        /// Server only - pass datagram with ID of this connection, from any thread.
+        /// Datagrams without the offered token are dropped here, before anything is copied.
+        void ReceiveDatagram(const asio::ip::udp::endpoint& from, const DatagramView& datagram);
+    private:
+        /// Frame goes over the side channel
+        [[nodiscard]] inline bool IsUnreliable(const Frame_ptr& frame) const noexcept
+        {
+            return m_DatagramOptions.Unreliable.test(frame->Header.ID) &&
+                   frame->Header.Flags == PacketFlags{} &&
+                   frame->Body.Frame().size() + DatagramHeader::Size <= MaxDatagramSize &&
+                   IsDatagramReady();
+        }
+        /// Send frame as datagram, from any thread
+        void SendDatagram(const Frame_ptr& frame);
+        /// Server - send `DatagramOffer` to the client which just joined
+        void OfferDatagrams();
+        /// Client - open own socket and start saying hello to the server
+        void AcceptDatagrams(PacketBuffer& offerBody);
+        /// ASYNC - Client - send hello until the server answers
+        void SendDatagramHello();
+        /// ASYNC - Client - receive datagrams from the server
+        void ReadDatagram();
+        /// Copy of the packet in the datagram, nothing for hello
+        [[nodiscard]] static std::optional<PacketSendInfo> DatagramPacket(const DatagramView& datagram);
+        /// Handle received datagram, from the strand
+        void OnDatagram(const asio::ip::udp::endpoint& from, const DatagramHeader& header, std::optional<PacketSendInfo> packet);
+
+    // Limit of received packets waiting for the owner to process them.
+    // When reached, reading from the socket is paused and TCP flow control slows down the remote side.
+    // The owner resumes reading once it processed enough of them.
+    private:
+        std::atomic<std::size_t> m_PendingIncoming    = 0;
+        std::size_t              m_MaxPendingIncoming = 0;
+        /// Reading waits for `OnIncomingProcessed`, whoever clears it continues reading
+        std::atomic<bool>        m_ReadPaused         = false;
+    public:
+        [[nodiscard]] inline std::size_t PendingIncoming() const noexcept { return m_PendingIncoming.load(std::memory_order_relaxed); }
+        /// 0 = unlimited.
+        /// Only for connections owned by server, their messages are marked as processed by `PacketServer::Update`.
+        inline void SetMaxPendingIncoming(std::size_t max) noexcept { m_MaxPendingIncoming = max; }
+        /// Called by the owner after it processed a message of this connection.
+        inline void OnIncomingProcessed()
+        {
+            // Sequentially consistent with `ContinueReading` - one of them always sees the other
+            std::size_t pending = m_PendingIncoming.fetch_sub(1) - 1;
+            if(m_MaxPendingIncoming != 0 && pending < m_MaxPendingIncoming && m_ReadPaused.load() && m_ReadPaused.exchange(false))
+                asio::post(m_Strand, [self = this->shared_from_this()]() { self->ResumeReading(); });
+        }
+    private:
+        /// ASYNC - Read next message unless too many received messages are waiting
+        void ContinueReading();
+        /// Continue reading paused by `ContinueReading`, from the strand
+        inline void ResumeReading()
+        {
+            if(m_Socket.is_open())
+                ReadHeader();
+        }
+
+    // Information about number of processed packets and bytes.
     // For statistics.
     private:
-        std::size_t m_ReceivedPacketCount = 0;
-        std::size_t m_SentPacketCount = 0;
+        TrafficStats  m_Stats       = {};
+        /// Server-wide aggregate, every change is applied there too
+        TrafficStats* m_ServerStats = nullptr;
+    private:
+        inline void StatAdd(std::atomic<uint64_t> TrafficStats::* counter, uint64_t value) noexcept
+        {
+            TrafficStats::Add(m_Stats.*counter, value);
+            if(m_ServerStats)
+                TrafficStats::Add(m_ServerStats->*counter, value);
+        }
+        inline void StatMax(std::atomic<uint64_t> TrafficStats::* counter, uint64_t value) noexcept
+        {
+            TrafficStats::Max(m_Stats.*counter, value);
+            if(m_ServerStats)
+                TrafficStats::Max(m_ServerStats->*counter, value);
+        }
     public:
-        [[nodiscard]] inline std::size_t ReceivedPacketCount() const noexcept { return m_ReceivedPacketCount; }
-        [[nodiscard]] inline std::size_t SentPacketCount()     const noexcept { return m_SentPacketCount; }
+        [[nodiscard]] inline const TrafficStats& Stats()               const noexcept { return m_Stats; }
+        [[nodiscard]] inline std::size_t         ReceivedPacketCount() const noexcept { return m_Stats.PacketsIn.load(std::memory_order_relaxed); }
+        [[nodiscard]] inline std::size_t         SentPacketCount()     const noexcept { return m_Stats.PacketsOut.load(std::memory_order_relaxed); }
+        /// Must outlive the connection.
+        inline void SetServerStats(TrafficStats* stats) noexcept { m_ServerStats = stats; }
     };
 }
 namespace AWEngine::Packet::Util
 {
     template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
-    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WriteHeader()
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WriteNext()
+    {
+        if(m_Writing)
+            return;
+
+        // Alternate between messages and fragments so big transfers do not block other packets and other packets do not starve them
+        if(!m_StreamsOut.empty() && (m_MessagesOut.empty() || m_FragmentTurn))
+        {
+            m_MessagesOut.push_front(NextFragment());
+            m_FragmentTurn = false;
+        }
+        else
+        {
+            m_FragmentTurn = true;
+        }
+
+        if(m_MessagesOut.empty())
+        {
+            if(m_CloseWhenSent && m_Socket.is_open())
+            {
+                // Graceful close, the remote side reads everything before the end of stream
+                asio::error_code ec;
+                m_Socket.shutdown(asio::socket_base::shutdown_send, ec);
+                m_Socket.close(ec);
+
+                if(m_Handshake && m_Handshake->OnStatusServed && m_ClientState.load(std::memory_order_relaxed) == ClientState::ServerInfo)
+                    m_Handshake->OnStatusServed(this->shared_from_this());
+            }
+            return;
+        }
+
+        m_Writing = true;
+        if(IsZeroCopy(m_MessagesOut.front()))
+            WriteZeroCopy();
+        else if(m_DeferredSend)
+            WriteBatch();
+        else
+            WriteFrame();
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::DropOutgoing()
+    {
+        StatAdd(&TrafficStats::Drops, m_MessagesOut.size() + m_StreamsOut.size());
+        m_MessagesOut.clear();
+        m_StreamsOut.clear();
+        m_Writing = false;
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        m_ZeroCopyOffset = 0;
+#endif
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    typename Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Frame_ptr Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::NextFragment()
+    {
+        OutgoingStream& stream = m_StreamsOut.front();
+        const PacketBuffer& body = *stream.Body;
+
+        PacketSendInfo info = PacketSendInfo::NewFrame(stream.ID, PacketFlags::Fragment);
+
+        FragmentKind kind       = FragmentKind::Middle;
+        std::size_t  headerSize = FragmentHeaderSize;
+        if(stream.Offset == 0)
+        {
+            kind |= FragmentKind::First;
+            headerSize = FragmentFirstHeaderSize;
+        }
+
+        std::size_t chunkSize = (std::min)(m_FragmentSize - headerSize, body.size() - stream.Offset);
+        if(stream.Offset + chunkSize == body.size())
+            kind |= FragmentKind::Last;
+
+        info.Body.reserve(headerSize + chunkSize);
+        info.Body << stream.StreamID << static_cast<uint8_t>(kind);
+        if(kind & FragmentKind::First)
+            info.Body << static_cast<uint64_t>(body.size());
+        info.Body.Write(chunkSize, body.data() + stream.Offset);
+        info.SealFrame();
+
+        Frame_ptr frame = std::make_shared<const PacketSendInfo>(std::move(info));
+
+        stream.Offset += chunkSize;
+        if(kind & FragmentKind::Last)
+        {
+#ifdef AWE_PACKET_COROUTINE
+            // `Send` waits for the whole packet
+            if(stream.Body.get() == m_SendWaiter)
+                m_SendWaiter = frame.get();
+#endif
+            m_StreamsOut.pop_front();
+        }
+        else if(m_StreamsOut.size() > 1)
+        {
+            // Round-robin between streams
+            m_StreamsOut.push_back(std::move(stream));
+            m_StreamsOut.pop_front();
+        }
+
+        return frame;
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    bool Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ReceiveFragment()
+    {
+        PacketBuffer& in = m_WipInMessage.Body;
+        if(in.size() < FragmentHeaderSize)
+            throw std::runtime_error("Fragment is too small");
+
+        uint16_t streamID;
+        uint8_t  kindValue;
+        in >> streamID >> kindValue;
+        auto kind = static_cast<FragmentKind>(kindValue);
+
+        auto it = m_StreamsIn.find(streamID);
+        if(kind & FragmentKind::First)
+        {
+            if(it != m_StreamsIn.end())
+                throw std::runtime_error("Fragment stream started twice");
+
+            uint64_t totalSize;
+            in >> totalSize;
+            if(!m_OnStreamChunk)
+            {
+                if(totalSize > m_MaxReassemblySize - m_ReassemblySize)
+                    throw std::runtime_error("Fragmented packet is too big");
+                m_ReassemblySize += totalSize;
+            }
+
+            it = m_StreamsIn.emplace(streamID, IncomingStream{ m_WipInMessage.Header.ID, totalSize }).first;
+        }
+        else if(it == m_StreamsIn.end())
+        {
+            throw std::runtime_error("Fragment of unknown stream");
+        }
+
+        IncomingStream& stream = it->second;
+        if(stream.ID != m_WipInMessage.Header.ID)
+            throw std::runtime_error("Fragment ID does not match its stream");
+        if(in.size() > stream.TotalSize - stream.Received)
+            throw std::runtime_error("Fragment exceeds size of its stream");
+        if(static_cast<bool>(kind & FragmentKind::Last) != (stream.Received + in.size() == stream.TotalSize))
+            throw std::runtime_error("Fragment stream ended at unexpected position");
+
+        if(m_OnStreamChunk)
+            m_OnStreamChunk(StreamChunk{ stream.ID, streamID, stream.TotalSize, stream.Received, in.data(), in.size() });
+        else
+            stream.Body.Write(in.size(), in.data());
+        stream.Received += in.size();
+
+        if(!(kind & FragmentKind::Last))
+            return false;
+
+        bool reassembled = !m_OnStreamChunk;
+        if(reassembled)
+        {
+            m_ReassemblySize -= stream.TotalSize;
+
+            // Size does not fit into the header, `Body.size()` has to be used
+            m_WipInMessage.Header.Size = 0;
+            m_WipInMessage.Body = std::move(stream.Body);
+        }
+        m_StreamsIn.erase(it);
+        return reassembled;
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WriteFrame()
     {
         if(!IsConnected())
-            throw std::runtime_error("Not Connected - WriteHeader()");
+            throw std::runtime_error("Not Connected - WriteFrame()");
 
         // If this function is called, we know the outgoing message queue must have at least one message to send.
-        // So allocate a transmission buffer to hold the message, and issue the work - asio, send these bytes
+        // Header is already in front of the body so the whole message is a single region.
         asio::async_write(
             m_Socket,
-            asio::buffer(&m_MessagesOut.peek_front().Header, sizeof(PacketSendInfo::Header)),
-            [this](std::error_code ec, std::size_t length)
+            m_MessagesOut.front()->Body.Frame(),
+            asio::bind_executor(m_Strand, [this](asio::error_code ec, std::size_t length)
             {
                 // asio has now sent the bytes - if there was a problem an error would be available...
                 if(!ec)
                 {
-                    // ... no error, so check if the message header just sent also has a message body...
-                    if(!m_MessagesOut.peek_front().Body.empty())
-                    {
-                        // ...it does, so issue the task to write the body bytes
-                        WriteBody();
-                    }
-                    else
-                    {
-                        // ...it didnt, so we are done with this message.
-                        // Remove it from the outgoing message queue
-                        m_MessagesOut.pop_front();
+                    // ... no error, so we are done with this message.
+                    // Remove it from the outgoing message queue
+                    OnFrameWritten(m_MessagesOut.front().get());
+                    m_MessagesOut.pop_front();
 
-                        m_LastSentMessageTime = std::chrono::system_clock::now();
-                        m_SentPacketCount++;
+                    m_LastSentMessageTime = CoarseClock::Now();
+                    StatAdd(&TrafficStats::PacketsOut, 1);
+                    StatAdd(&TrafficStats::BytesOut, length);
 
-                        // If the queue is not empty, there are more messages to send, so make this happen by issuing the task to send the next header.
-                        if(!m_MessagesOut.empty())
-                            WriteHeader();
-                    }
+                    // If there are more messages to send, make this happen by issuing the task to send the next one.
+                    m_Writing = false;
+                    WriteNext();
                 }
                 else
                 {
                     // ...asio failed to write the message, we could analyse why but for now simply assume the connection has died by closing the socket.
                     // When a future attempt to write to this client fails due to the closed socket, it will be tidied up.
-                    std::cerr << "Write Header Fail: " << ec.value() << " - " << ec.message() << std::endl;
+                    std::cerr << "Write Fail: " << ec.value() << " - " << ec.message() << std::endl;
                     m_Socket.close();
+
+                    DropOutgoing();
+                    FailPending(ec);
                 }
-            }
+            })
         );
     }
 
     template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
-    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WriteBody()
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WriteBatch()
     {
-        // If this function is called, a header has just been sent, and that header indicated a body existed for this message.
-        // Fill a transmission buffer with the body data, and send it!
+        if(!IsConnected())
+            throw std::runtime_error("Not Connected - WriteBatch()");
+
+        // Everything queued so far goes out in one write, messages queued meanwhile wait for the next batch.
+        // Zero-copy message ends the batch, it is sent by its own call.
+        m_BatchSize = 0;
+        m_BatchBuffers.clear();
+        for(const Frame_ptr& frame : m_MessagesOut)
+        {
+            if(IsZeroCopy(frame))
+                break;
+            m_BatchBuffers.emplace_back(frame->Body.Frame());
+            m_BatchSize++;
+        }
+
+        // std::deque keeps references valid when pushing to the back so the buffers stay valid until the write completes
         asio::async_write(
             m_Socket,
-            asio::buffer(m_MessagesOut.peek_front().Body.data(), m_MessagesOut.peek_front().Body.size()),
-            [this](std::error_code ec, std::size_t length)
+            m_BatchBuffers,
+            asio::bind_executor(m_Strand, [this](asio::error_code ec, std::size_t length)
             {
                 if(!ec)
                 {
-                    // Sending was successful, so we are done with the message and remove it from the queue
-                    m_MessagesOut.pop_front();
+                    for(std::size_t i = 0; i < m_BatchSize; i++)
+                        OnFrameWritten(m_MessagesOut[i].get());
+                    m_MessagesOut.erase(m_MessagesOut.begin(), m_MessagesOut.begin() + m_BatchSize);
 
-                    m_LastSentMessageTime = std::chrono::system_clock::now();
-                    m_SentPacketCount++;
+                    m_LastSentMessageTime = CoarseClock::Now();
+                    StatAdd(&TrafficStats::PacketsOut, m_BatchSize);
+                    StatAdd(&TrafficStats::BytesOut, length);
+                    m_BatchSize = 0;
 
-                    // If the queue still has messages in it, then issue the task to send the next messages' header.
-                    if(!m_MessagesOut.empty())
-                        WriteHeader();
+                    // Messages flushed while the batch was being written
+                    m_Writing = false;
+                    WriteNext();
                 }
                 else
                 {
-                    // Sending failed, see WriteHeader() equivalent for description :P
-                    std::cerr << "Write Body Fail: " << ec.value() << " - " << ec.message() << std::endl;
+                    // Sending failed, see WriteFrame() equivalent for description
+                    std::cerr << "Write Batch Fail: " << ec.value() << " - " << ec.message() << std::endl;
                     m_Socket.close();
+
+                    m_BatchSize = 0;
+                    DropOutgoing();
+                    FailPending(ec);
                 }
+            })
+        );
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    bool Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::SetZeroCopyThreshold(std::size_t bytes)
+    {
+        if(bytes == 0)
+        {
+            m_ZeroCopyThreshold = 0;
+            return true;
+        }
+
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        asio::error_code ec;
+        m_Socket.set_option(asio::detail::socket_option::boolean<SOL_SOCKET, SO_ZEROCOPY>(true), ec);
+        if(ec)
+            return false;
+
+        m_ZeroCopyThreshold = bytes;
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WriteZeroCopy()
+    {
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        while(true)
+        {
+            const Frame_ptr& frame = m_MessagesOut.front();
+            asio::const_buffer data = frame->Body.Frame() + m_ZeroCopyOffset;
+
+            iovec  part   = { const_cast<void*>(data.data()), data.size() };
+            msghdr header = {};
+            header.msg_iov    = &part;
+            header.msg_iovlen = 1;
+
+            ssize_t sent = ::sendmsg(m_Socket.native_handle(), &header, MSG_ZEROCOPY | MSG_DONTWAIT | MSG_NOSIGNAL);
+            if(sent >= 0)
+            {
+                // Every successful call gets a sequence number, the frame is released once its last call completes
+                if(m_Pinned.empty() || m_Pinned.back().Frame != frame)
+                    m_Pinned.push_back(PinnedFrame{ m_ZeroCopyCall, frame });
+                else
+                    m_Pinned.back().LastCall = m_ZeroCopyCall;
+                m_ZeroCopyCall++;
             }
+            else if(errno == ENOBUFS)
+            {
+                // Too many completions not collected yet (optmem limit), copy this part
+                sent = ::sendmsg(m_Socket.native_handle(), &header, MSG_DONTWAIT | MSG_NOSIGNAL);
+            }
+
+            if(sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                asio::error_code ec(errno, asio::error::get_system_category());
+                std::cerr << "Write Zero-Copy Fail: " << ec.value() << " - " << ec.message() << std::endl;
+                m_Socket.close();
+
+                DropOutgoing();
+                FailPending(ec);
+                return;
+            }
+
+            if(sent > 0)
+                m_ZeroCopyOffset += static_cast<std::size_t>(sent);
+            if(m_ZeroCopyOffset < frame->Body.Frame().size())
+                break; // Send buffer is full
+
+            OnFrameWritten(frame.get());
+            m_LastSentMessageTime = CoarseClock::Now();
+            StatAdd(&TrafficStats::PacketsOut, 1);
+            StatAdd(&TrafficStats::BytesOut, frame->Body.Frame().size());
+            StatAdd(&TrafficStats::ZeroCopySends, 1);
+
+            m_MessagesOut.pop_front();
+            m_ZeroCopyOffset = 0;
+            WaitZeroCopyCompletion();
+
+            // Other messages are written the usual way
+            if(m_MessagesOut.empty() || !IsZeroCopy(m_MessagesOut.front()))
+            {
+                m_Writing = false;
+                WriteNext();
+                return;
+            }
+        }
+
+        // Continue once there is space in the send buffer
+        m_Socket.async_wait(
+            asio::socket_base::wait_write,
+            asio::bind_executor(m_Strand, [this](asio::error_code ec)
+            {
+                if(!ec)
+                {
+                    WriteZeroCopy();
+                }
+                else
+                {
+                    std::cerr << "Write Zero-Copy Fail: " << ec.value() << " - " << ec.message() << std::endl;
+                    m_Socket.close();
+
+                    DropOutgoing();
+                    FailPending(ec);
+                }
+            })
+        );
+#endif
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::WaitZeroCopyCompletion()
+    {
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        if(m_Pinned.empty() || m_WaitingErrorQueue)
+            return;
+
+        // Waiting before collecting so a completion arriving in between is not missed
+        m_WaitingErrorQueue = true;
+        m_Socket.async_wait(
+            asio::socket_base::wait_error,
+            asio::bind_executor(m_Strand, [this](asio::error_code ec)
+            {
+                m_WaitingErrorQueue = false;
+
+                // Socket closed, pinned frames are released with the connection
+                if(ec)
+                    return;
+
+                CollectZeroCopyCompletions();
+                WaitZeroCopyCompletion();
+            })
         );
+        CollectZeroCopyCompletions();
+#endif
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::CollectZeroCopyCompletions()
+    {
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+        while(!m_Pinned.empty())
+        {
+            alignas(cmsghdr) uint8_t control[128];
+            msghdr header = {};
+            header.msg_control    = control;
+            header.msg_controllen = sizeof(control);
+            if(::recvmsg(m_Socket.native_handle(), &header, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+                return; // Nothing more reported
+
+            for(cmsghdr* message = CMSG_FIRSTHDR(&header); message != nullptr; message = CMSG_NXTHDR(&header, message))
+            {
+                bool isError = (message->cmsg_level == SOL_IP && message->cmsg_type == IP_RECVERR) || (message->cmsg_level == SOL_IPV6 && message->cmsg_type == IPV6_RECVERR);
+                if(!isError)
+                    continue;
+
+                sock_extended_err error;
+                std::memcpy(&error, CMSG_DATA(message), sizeof(error));
+                if(error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+                    continue;
+
+                // Calls from `ee_info` to `ee_data` are done, TCP completes them in order
+                if(error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                    StatAdd(&TrafficStats::ZeroCopyCopied, error.ee_data - error.ee_info + 1);
+                while(!m_Pinned.empty() && static_cast<int32_t>(error.ee_data - m_Pinned.front().LastCall) >= 0)
+                    m_Pinned.pop_front();
+            }
+        }
+#endif
     }
 
     template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
     void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ReadHeader()
     {
+        if(m_ReceivePool)
+        {
+            ReadBuffered();
+            return;
+        }
+
         // If this function is called, we are expecting asio to wait until it receives enough bytes to form a header of a message.
-        // We know the headers are a fixed size, so allocate a transmission buffer large enough to store it.
+        // We know the headers are a fixed size, the body buffer reserves space for it in front of the values (same layout as sending).
         // In fact, we will construct the message in a "temporary" message object as it's convenient to work with.
+        m_WipInMessage.Body.Clear(); // Previous body may have been moved out or partially read (fragment header)
+        m_WipInMessage.Body.ReservePrefix(PacketSendInfo::HeaderSize);
         asio::async_read(
             m_Socket,
-            asio::buffer(&m_WipInMessage.Header, sizeof(PacketSendInfo::Header)),
-            [this](std::error_code ec, std::size_t length)
+            asio::buffer(m_WipInMessage.Body.Prefix(), PacketSendInfo::HeaderSize),
+            asio::bind_executor(m_Strand, [this](asio::error_code ec, std::size_t length)
             {
-                m_WipInMessage.Header.Size = be16toh(m_WipInMessage.Header.Size); // Swap from network to local endian
                 if(!ec)
                 {
+                    m_WipInMessage.ParseHeader();
                     if(m_WipInMessage.Header.Size == 0)
                     {
                         // Message without body, add it to received queue
@@ -257,8 +1100,9 @@ namespace AWEngine::Packet::Util
                     // Close the socket and let the system tidy it up later.
                     std::cerr << "Read Header Fail: " << ec.value() << " - " << ec.message() << std::endl;
                     m_Socket.close();
+                    FailPending(ec);
                 }
-            }
+            })
         );
     }
 
@@ -272,7 +1116,7 @@ namespace AWEngine::Packet::Util
         asio::async_read(
             m_Socket,
             asio::buffer(m_WipInMessage.Body.data(), m_WipInMessage.Body.size()),
-            [this](std::error_code ec, std::size_t length)
+            asio::bind_executor(m_Strand, [this](asio::error_code ec, std::size_t length)
             {
                 if(!ec)
                 {
@@ -280,6 +1124,7 @@ namespace AWEngine::Packet::Util
                     {
                         std::cerr << "Compression not implemented." << std::endl;
                         m_Socket.close();
+                        FailPending(asio::error::operation_not_supported);
                     }
                     else
                     {
@@ -291,81 +1136,531 @@ namespace AWEngine::Packet::Util
                 {
                     std::cerr << "Read Body Fail: " << ec.value() << " - " << ec.message() << std::endl;
                     m_Socket.close();
+                    FailPending(ec);
                 }
-            }
+            })
         );
     }
 
     template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
-    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::AddToIncomingMessageQueue()
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ReadBuffered()
     {
-        OwnedMessage_t msg = OwnedMessage_t{ nullptr, m_WipInMessage };
-        if(m_Direction == PacketDirection::ToClient) // Server's connection
-            msg.first = this->shared_from_this();
-
-        m_LastReceivedMessageTime = std::chrono::system_clock::now();
-        m_ReceivedPacketCount++;
+        // Processing a packet asks for the next one (`ContinueReading`), packets already received are cut in a loop
+        m_NextPacketWanted = true;
+        if(m_CuttingPackets)
+            return;
 
-        if(msg.second.Header.ID == PacketID_KeepAlive)
+        m_CuttingPackets = true;
+        while(m_NextPacketWanted && m_Socket.is_open())
         {
-            if(msg.second.Header.Flags != PacketFlags{})
-                throw std::runtime_error("KeepAlive packet cannot have any flags");
-            if(msg.second.Header.Size != sizeof(uint64_t))
-                throw std::runtime_error("KeepAlive packet has invalid size");
+            m_NextPacketWanted = false;
 
-            if(m_Direction == PacketDirection::ToServer) // Owned by client
+            const uint8_t* received  = m_ReceivePool->Data(m_ReceiveBufferSlot) + m_ReceiveBegin;
+            std::size_t    available = m_ReceiveEnd - m_ReceiveBegin;
+            if(available >= PacketSendInfo::HeaderSize)
             {
-                m_LastKeepAlive = std::chrono::system_clock::now();
+                uint16_t size;
+                std::memcpy(&size, received + 2, sizeof(size));
+                size = be16toh(size); // Swap from network to local endian
 
-                // Send back
-                uint64_t payload = *reinterpret_cast<const uint64_t*>(msg.second.Body.data());
-                Send(::AWEngine::Packet::Ping<TPacketID, PacketID_KeepAlive>(payload));
-            }
+                if(available >= PacketSendInfo::HeaderSize + size)
+                {
+                    // Same layout as reading header and body directly
+                    m_WipInMessage.Body.Clear();
+                    m_WipInMessage.Body.ReservePrefix(PacketSendInfo::HeaderSize);
+                    std::memcpy(m_WipInMessage.Body.Prefix(), received, PacketSendInfo::HeaderSize);
+                    m_WipInMessage.ParseHeader();
+                    m_WipInMessage.Body.resize(size);
+                    std::memcpy(m_WipInMessage.Body.data(), received + PacketSendInfo::HeaderSize, size);
+                    m_ReceiveBegin += PacketSendInfo::HeaderSize + size;
 
-            if(m_Direction == PacketDirection::ToClient) // Owned by server
-            {
-                uint64_t payload = *reinterpret_cast<const uint64_t*>(msg.second.Body.data());
-                if(payload == m_LastKeepAliveValue)
-                    m_LastKeepAlive = std::chrono::system_clock::now();
+                    if(m_WipInMessage.Header.Flags & PacketFlags::Compressed)
+                    {
+                        std::cerr << "Compression not implemented." << std::endl;
+                        m_Socket.close();
+                        FailPending(asio::error::operation_not_supported);
+                        break;
+                    }
+
+                    AddToIncomingMessageQueue();
+                    continue;
+                }
+            }
+
+            // Incomplete packet goes to the front so the rest of it fits behind
+            if(m_ReceiveBegin != 0)
+            {
+                std::memmove(m_ReceivePool->Data(m_ReceiveBufferSlot), received, available);
+                m_ReceiveBegin = 0;
+                m_ReceiveEnd   = available;
+            }
+            ReadSome();
+        }
+        m_CuttingPackets = false;
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ReadSome()
+    {
+        m_Socket.async_read_some(
+            m_ReceivePool->Buffer(m_ReceiveBufferSlot, m_ReceiveEnd),
+            asio::bind_executor(m_Strand, [this](asio::error_code ec, std::size_t length)
+            {
+                if(!ec)
+                {
+                    m_ReceiveEnd += length;
+                    ReadBuffered();
+                }
                 else
-                    m_LastKeepAlive = TimePoint_t(); // Will cause it to drop in next KeepAlive check
+                {
+                    std::cerr << "Read Fail: " << ec.value() << " - " << ec.message() << std::endl;
+                    m_Socket.close();
+                    FailPending(ec);
+                }
+            })
+        );
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::AddToIncomingMessageQueue()
+    {
+        m_LastReceivedMessageTime.store(CoarseClock::Now(), std::memory_order_relaxed);
+        StatAdd(&TrafficStats::PacketsIn, 1);
+        StatAdd(&TrafficStats::BytesIn, PacketSendInfo::HeaderSize + m_WipInMessage.Header.Size);
+
+        if(m_WipInMessage.Header.Flags & PacketFlags::Fragment)
+        {
+            bool reassembled;
+            try
+            {
+                reassembled = ReceiveFragment();
+            }
+            catch(std::exception& ex)
+            {
+                std::cerr << "Invalid fragment: " << ex.what() << std::endl;
+                m_Socket.close();
+                FailPending(asio::error::invalid_argument);
+                return;
+            }
+
+            if(!reassembled)
+            {
+                ContinueReading();
+                return;
             }
         }
 
-        if(msg.second.Header.ID == PacketID_Init)
+        // Next ReadHeader() starts with a new body
+        OwnedMessage_t msg = OwnedMessage_t{ nullptr, std::move(m_WipInMessage) };
+        if(m_Direction == PacketDirection::ToClient) // Server's connection
+            msg.first = this->shared_from_this();
+
+        if(m_Direction == PacketDirection::ToServer && msg.second.Header.ID == static_cast<uint8_t>(PacketID_Init) && (msg.second.Header.Flags & PacketFlags::Datagram)) // Owned by client
         {
-            if(m_Direction == PacketDirection::ToClient) // Owned by server
+            // Offer of the side channel never reaches the game
+            if(m_DatagramOptions.Enabled && !m_Datagrams)
+            {
+                try
+                {
+                    AcceptDatagrams(msg.second.Body);
+                }
+                catch(std::exception& ex)
+                {
+                    std::cerr << "Side channel not available: " << ex.what() << std::endl;
+                }
+            }
+            ContinueReading();
+            return;
+        }
+
+        if(msg.second.Header.ID == static_cast<uint8_t>(PacketID_KeepAlive))
+        {
+            if(msg.second.Header.Flags != PacketFlags{})
+                throw std::runtime_error("KeepAlive packet cannot have any flags");
+            if(msg.second.Header.Size != sizeof(uint64_t))
+                throw std::runtime_error("KeepAlive packet has invalid size");
+
+            if(m_Direction == PacketDirection::ToServer) // Owned by client
             {
-                if(msg.second.Header.Flags != PacketFlags{})
-                    throw std::runtime_error("Init packet cannot have any flags");
-                if(msg.second.Header.Size != 17)
-                    throw std::runtime_error("Init packet has invalid size");
+                m_LastKeepAlive = CoarseClock::Now();
 
-                ::AWEngine::Packet::ToServer::Login::Init<TPacketID, PacketID_Init> initPacket = ::AWEngine::Packet::ToServer::Login::Init<TPacketID, PacketID_Init>(msg.second.Body);
-                switch(initPacket.Next)
+                // Send back
+                uint64_t payload;
+                std::memcpy(&payload, msg.second.Body.data(), sizeof(payload)); // Body is behind the header, not aligned
+                Send(::AWEngine::Packet::Ping<TPacketID, PacketID_KeepAlive>(payload));
+            }
+
+            if(m_Direction == PacketDirection::ToClient) // Owned by server
+            {
+                uint64_t payload;
+                std::memcpy(&payload, msg.second.Body.data(), sizeof(payload)); // Body is behind the header, not aligned
+                if(payload == m_LastKeepAliveValue)
                 {
-                    default:
-                        throw std::runtime_error("Unknown Init packet next stage");
-                    case ::AWEngine::Packet::ToServer::Login::NextInitStep::ServerInfo:
-                        //TODO send server info
-                        return;//TODO ReadHeader()
-                    case ::AWEngine::Packet::ToServer::Login::NextInitStep::Join:
-                        //TODO
-                        return;//TODO ReadHeader()
+                    m_LastKeepAlive = CoarseClock::Now();
+
+                    // Payload is the time the Ping was created (see `Ping()`)
+                    std::chrono::nanoseconds sentAt(le64toh(payload));
+                    std::chrono::nanoseconds now = CoarseClock::PreciseNow().time_since_epoch();
+                    if(sentAt.count() != 0 && sentAt <= now)
+                    {
+                        m_Rtt.Record(now - sentAt);
+                        if(m_ServerLatency)
+                            m_ServerLatency->Record(now - sentAt);
+                    }
                 }
+                // Otherwise response to an older KeepAlive, not measured
             }
         }
 
         if(m_Direction == PacketDirection::ToClient) // Owned by server
         {
-            //TODO Add check for too many messages waiting to be processed (denial-of-service attack)
+            bool handshakeDone;
+            try
+            {
+                handshakeDone = Handshake(msg.second);
+            }
+            catch(std::exception& ex)
+            {
+                std::cerr << "Invalid handshake: " << ex.what() << std::endl;
+                m_Socket.close();
+                FailPending(asio::error::invalid_argument);
+                return;
+            }
+
+            // Answered on this thread, reading does not continue
+            if(!handshakeDone)
+                return;
+        }
+
+#ifdef AWE_PACKET_COROUTINE
+        if(m_SessionMode)
+        {
+            // Answered above, the session only sees packets of the game
+            if(msg.second.Header.ID == static_cast<uint8_t>(PacketID_KeepAlive))
+            {
+                ContinueReading();
+                return;
+            }
+
+            // Join accepted by the handshake, reading continues once the session calls `Receive`
+            if(msg.second.Header.ID == static_cast<uint8_t>(PacketID_Init))
+            {
+                if(m_Handshake && m_Handshake->OnJoined)
+                    m_Handshake->OnJoined(msg.first);
+                return;
+            }
+
+            m_ReceiveSlot.Complete(asio::error_code{}, std::move(msg.second));
+            return;
         }
+#endif
+
+        // Limit of waiting messages is checked by `ContinueReading` below
+        if(m_Direction == PacketDirection::ToClient) // Owned by server
+            StatMax(&TrafficStats::PendingInHighWater, m_PendingIncoming.fetch_add(1, std::memory_order_relaxed) + 1);
 
         m_MessagesIn.push_back(std::move(msg));
 
         // We must now prime the asio context to receive the next message.
         // It wil just sit and wait for bytes to arrive, and the message construction process repeats itself.
         // Clever huh?
+        ContinueReading();
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    bool Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Handshake(PacketSendInfo& msg)
+    {
+        bool isInit = msg.Header.ID == static_cast<uint8_t>(PacketID_Init);
+        switch(m_ClientState.load(std::memory_order_relaxed))
+        {
+            case ClientState::Play:
+                if(isInit)
+                    throw std::runtime_error("Init packet received twice");
+                return true;
+            case ClientState::ServerInfo:
+                throw std::runtime_error("Packet received after status request");
+            case ClientState::Unknown:
+            default:
+                break;
+        }
+
+        if(!isInit)
+            throw std::runtime_error("First packet must be Init");
+        if(msg.Header.Flags != PacketFlags{})
+            throw std::runtime_error("Init packet cannot have any flags");
+        if(msg.Header.Size != 17)
+            throw std::runtime_error("Init packet has invalid size");
+
+        // Read from a copy, the body is passed to the owner unread
+        PacketBuffer body = msg.Body;
+        ::AWEngine::Packet::ToServer::Login::Init<TPacketID, PacketID_Init> initPacket(body);
+        switch(initPacket.Next)
+        {
+            default:
+                throw std::runtime_error("Unknown Init packet next stage");
+
+            case ::AWEngine::Packet::ToServer::Login::NextInitStep::ServerInfo:
+            {
+                // Any game or version may ask, pre-serialized response is shared by all connections
+                m_ClientState.store(ClientState::ServerInfo, std::memory_order_relaxed);
+                Frame_ptr info = m_Handshake ? m_Handshake->ServerInfo.load(std::memory_order_acquire) : nullptr;
+                if(!info)
+                    throw std::runtime_error("Server provides no info");
+                Finish(std::move(info));
+                return false;
+            }
+
+            case ::AWEngine::Packet::ToServer::Login::NextInitStep::Join:
+                if(m_Handshake && (!(initPacket.GameName == m_Handshake->GameName) || initPacket.GameVersion != m_Handshake->GameVersion))
+                {
+                    Finish(m_Handshake->Incompatible);
+                    return false;
+                }
+                if(m_Handshake && m_Handshake->AdmitPlayer)
+                {
+                    if(!m_Handshake->AdmitPlayer())
+                    {
+                        StatAdd(&TrafficStats::Rejected, 1);
+                        Finish(m_Handshake->ServerFull);
+                        return false;
+                    }
+
+                    // Removed by the server in the meantime, nobody else would return the place
+                    PlayerPlace expected = PlayerPlace::None;
+                    if(!m_PlayerPlace.compare_exchange_strong(expected, PlayerPlace::Taken, std::memory_order_acq_rel))
+                        m_Handshake->ReleasePlayer();
+                }
+
+                // Pass the Init packet to the game and keep reading
+                m_ClientState.store(ClientState::Play, std::memory_order_relaxed);
+                if(m_Datagrams)
+                    OfferDatagrams();
+                return true;
+        }
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Finish(Frame_ptr frame)
+    {
+        m_CloseWhenSent = true;
+        if(frame)
+            m_MessagesOut.emplace_back(std::move(frame));
+        WriteNext();
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::OfferDatagrams()
+    {
+        // Coroutine sessions pull packets with `Receive` which reads the socket, datagrams would need a reader of their own
+#ifdef AWE_PACKET_COROUTINE
+        if(m_SessionMode)
+            return;
+#endif
+
+        asio::error_code ec;
+        asio::ip::udp::endpoint local = m_Datagrams->Socket.local_endpoint(ec);
+        if(ec)
+            return;
+
+        std::random_device random;
+        m_DatagramHeader.Id    = m_Id;
+        do
+            m_DatagramHeader.Token = (static_cast<uint64_t>(random()) << 32) | random();
+        while(m_DatagramHeader.Token == 0);
+        m_DatagramToken.store(m_DatagramHeader.Token, std::memory_order_release);
+
+        PacketSendInfo info = PacketSendInfo::NewFrame(static_cast<uint8_t>(PacketID_Init), PacketFlags::Datagram);
+        DatagramOffer{ m_DatagramHeader.Id, m_DatagramHeader.Token, local.port() }.Write(info.Body);
+        info.SealFrame();
+
+        m_MessagesOut.emplace_back(std::make_shared<const PacketSendInfo>(std::move(info)));
+        WriteNext();
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::AcceptDatagrams(PacketBuffer& offerBody)
+    {
+        DatagramOffer offer = DatagramOffer::Read(offerBody);
+        m_DatagramHeader.Id    = offer.Id;
+        m_DatagramHeader.Token = offer.Token;
+        m_DatagramPeer = asio::ip::udp::endpoint(m_Socket.remote_endpoint().address(), offer.Port);
+
+        m_Datagrams = std::make_shared<DatagramSocket>(m_IoContext, m_DatagramOptions.SimulatedLoss);
+        m_Datagrams->Open(asio::ip::udp::endpoint(m_DatagramPeer.protocol(), 0));
+        m_DatagramBuffer.resize(MaxDatagramSize);
+        m_DatagramHelloTimer.emplace(m_Strand);
+
+        ReadDatagram();
+        SendDatagramHello();
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::SendDatagramHello()
+    {
+        if(IsDatagramReady() || !m_Socket.is_open())
+            return;
+
+        if(m_DatagramHellos++ == DatagramHelloAttempts)
+        {
+            std::cerr << "Server does not answer datagrams, unreliable packets go over TCP" << std::endl;
+            return;
+        }
+
+        m_Datagrams->SendTo(m_DatagramPeer, m_DatagramHeader, asio::const_buffer());
+        m_DatagramHelloTimer->expires_after(DatagramHelloInterval);
+        m_DatagramHelloTimer->async_wait(
+            [this](asio::error_code ec)
+            {
+                if(!ec)
+                    SendDatagramHello();
+            }
+        );
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ReadDatagram()
+    {
+        m_Datagrams->Socket.async_receive_from(
+            asio::buffer(m_DatagramBuffer),
+            m_DatagramSender,
+            asio::bind_executor(m_Strand, [this](asio::error_code ec, std::size_t size)
+            {
+                if(ec == asio::error::operation_aborted || !m_Socket.is_open())
+                    return;
+
+                // Errors of a single datagram (e.g. truncated) do not stop the channel
+                if(!ec)
+                    if(std::optional<DatagramView> datagram = DatagramView::Parse(m_DatagramBuffer.data(), size))
+                        OnDatagram(m_DatagramSender, datagram->Header, DatagramPacket(*datagram));
+
+                ReadDatagram();
+            })
+        );
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ReceiveDatagram(const asio::ip::udp::endpoint& from, const DatagramView& datagram)
+    {
+        // Anyone can send to the port, the ID was only good for the lookup
+        uint64_t token = m_DatagramToken.load(std::memory_order_acquire);
+        if(token == 0 || datagram.Header.Token != token || datagram.Header.Id != m_Id)
+            return;
+
+        // Copied out of the receive buffer of the server before it is reused
+        asio::post(
+            m_Strand,
+            [self = this->shared_from_this(), from, header = datagram.Header, packet = DatagramPacket(datagram)]() mutable
+            {
+                self->OnDatagram(from, header, std::move(packet));
+            }
+        );
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    std::optional<PacketSendInfo> Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::DatagramPacket(const DatagramView& datagram)
+    {
+        if(datagram.IsHello())
+            return std::nullopt;
+
+        uint32_t bodySize = static_cast<uint32_t>(datagram.FrameSize - PacketSendInfo::HeaderSize);
+        PacketSendInfo info = PacketSendInfo::NewFrame(datagram.Frame[0], PacketFlags::Datagram, bodySize);
+        info.Body.Write(bodySize, datagram.Frame + PacketSendInfo::HeaderSize);
+        info.Header.Size = static_cast<uint16_t>(bodySize);
+        return info;
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::OnDatagram(const asio::ip::udp::endpoint& from, const DatagramHeader& header, std::optional<PacketSendInfo> packet)
+    {
+        if(!m_Socket.is_open() || m_DatagramHeader.Token == 0 || header.Token != m_DatagramHeader.Token || header.Id != m_DatagramHeader.Id)
+            return;
+
+        if(m_Direction == PacketDirection::ToClient) // Owned by server
+        {
+            // Address of the first datagram with correct token is used for the rest of the connection
+            if(!IsDatagramReady())
+            {
+                m_DatagramPeer = from;
+                m_DatagramReady.store(true, std::memory_order_release);
+            }
+            else if(from != m_DatagramPeer)
+            {
+                return;
+            }
+
+            // Let the client know the channel works
+            if(!packet)
+            {
+                m_Datagrams->SendTo(m_DatagramPeer, m_DatagramHeader, asio::const_buffer());
+                return;
+            }
+        }
+        else // Owned by client
+        {
+            if(from != m_DatagramPeer)
+                return;
+
+            // Answered hello or anything else means the server knows the address
+            if(!IsDatagramReady())
+            {
+                m_DatagramReady.store(true, std::memory_order_release);
+                m_DatagramHelloTimer->cancel();
+            }
+            if(!packet)
+                return;
+        }
+
+        // Same limit as packets received over TCP, datagrams cannot be paused so the excess is dropped
+        if(m_Direction == PacketDirection::ToClient && m_MaxPendingIncoming != 0 && m_PendingIncoming.load(std::memory_order_relaxed) >= m_MaxPendingIncoming)
+        {
+            StatAdd(&TrafficStats::Drops, 1);
+            return;
+        }
+
+        if(!m_DatagramFilter.Accept(packet->Header.ID, header.Sequence))
+        {
+            StatAdd(&TrafficStats::DatagramsStale, 1);
+            return;
+        }
+
+        m_LastReceivedMessageTime.store(CoarseClock::Now(), std::memory_order_relaxed);
+        StatAdd(&TrafficStats::DatagramsIn, 1);
+
+        OwnedMessage_t msg = OwnedMessage_t{ nullptr, std::move(*packet) };
+        if(m_Direction == PacketDirection::ToClient) // Server's connection
+        {
+            msg.first = this->shared_from_this();
+            StatMax(&TrafficStats::PendingInHighWater, m_PendingIncoming.fetch_add(1, std::memory_order_relaxed) + 1);
+        }
+        m_MessagesIn.push_back(std::move(msg));
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::SendDatagram(const Frame_ptr& frame)
+    {
+        DatagramHeader header = m_DatagramHeader;
+        header.Sequence = m_DatagramSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        if(m_Datagrams->SendTo(m_DatagramPeer, header, frame->Body.Frame()))
+            StatAdd(&TrafficStats::DatagramsOut, 1);
+        else
+            StatAdd(&TrafficStats::Drops, 1);
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ContinueReading()
+    {
+        if(m_MaxPendingIncoming != 0 && m_PendingIncoming.load() >= m_MaxPendingIncoming)
+        {
+            // Owner falls behind, it resumes reading from `OnIncomingProcessed`
+            StatAdd(&TrafficStats::ReadsPaused, 1);
+            m_ReadPaused.store(true);
+
+            // Unless it processed everything before seeing the flag
+            if(m_PendingIncoming.load() >= m_MaxPendingIncoming || !m_ReadPaused.exchange(false))
+                return;
+        }
+
         ReadHeader();
     }
 
@@ -377,14 +1672,16 @@ namespace AWEngine::Packet::Util
 
         if (m_Socket.is_open())
         {
-            ReadHeader();
+            // Called from the accepting thread, the socket may only be used from the strand
+            asio::post(m_Strand, [this]() { ReadHeader(); });
         }
     }
 
     template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
     void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ConnectToServer(
         const asio::ip::tcp::resolver::results_type& endpoints,
-        std::unique_ptr<IPacket<TPacketID>> initPacket
+        std::unique_ptr<IPacket<TPacketID>> initPacket,
+        const SocketOptions& socketOptions
     )
     {
         if(m_Direction == PacketDirection::ToClient)
@@ -393,18 +1690,51 @@ namespace AWEngine::Packet::Util
         m_IsConnecting = true;
         m_InitPacket = std::move(initPacket);
 
+        if(endpoints.empty())
+        {
+            m_IsConnecting = false;
+            std::cerr << "Failed to connect to the server: No endpoint" << std::endl;
+            return;
+        }
+
+        // Not `asio::async_connect` - it opens the socket itself right before connecting, too late for the receive buffer size
+        ConnectToEndpoint(endpoints, endpoints.begin(), socketOptions);
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::ConnectToEndpoint(
+        asio::ip::tcp::resolver::results_type endpoints,
+        asio::ip::tcp::resolver::results_type::const_iterator next,
+        SocketOptions socketOptions
+    )
+    {
+        asio::ip::tcp::endpoint endpoint = next->endpoint();
+
+        asio::error_code ec;
+        m_Socket.close(ec);
+        m_Socket.open(endpoint.protocol(), ec);
+        if(!ec)
+            ApplyPreConnectSocketOptions(m_Socket, socketOptions);
+
         // Request asio attempts to connect to an endpoint
-        asio::async_connect(
-            m_Socket,
-            endpoints,
-            [this](std::error_code ec, const asio::ip::tcp::endpoint& endpoint)
+        m_Socket.async_connect(
+            endpoint,
+            asio::bind_executor(m_Strand, [this, endpoints = std::move(endpoints), next, socketOptions](asio::error_code ec) mutable
             {
+                if (ec && ec != asio::error::operation_aborted && std::next(next) != endpoints.end())
+                {
+                    ConnectToEndpoint(std::move(endpoints), std::next(next), socketOptions);
+                    return;
+                }
+
                 m_IsConnecting = false;
 
                 if (!ec)
                 {
                     std::cout << "Connected to server" << std::endl;
 
+                    ApplySocketOptions(m_Socket, socketOptions);
+
                     Send(m_InitPacket);
 
                     ReadHeader();
@@ -413,7 +1743,7 @@ namespace AWEngine::Packet::Util
                 {
                     std::cerr << "Failed to connect to the server: " << ec.value() << " - " << ec.message() << std::endl;
                 }
-            }
+            })
         );
     }
 
@@ -421,7 +1751,39 @@ namespace AWEngine::Packet::Util
     void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Disconnect()
     {
         if (IsConnected())
-            asio::post(m_IoContext, [this]() { m_Socket.close(); });
+            asio::post(m_Strand, [this]() { m_Socket.close(); });
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    typename Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Frame_ptr Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::MakeFrame(const IPacket<TPacketID>& packet)
+    {
+        PacketSendInfo info = PacketSendInfo::NewFrame(static_cast<uint8_t>(packet.ID));
+
+        packet.Write(info.Body);
+
+        //TODO Compression
+
+        // Too big for a single frame, sent in fragments
+        if(info.Body.size() <= PacketBuffer::MaxSize)
+            info.SealFrame();
+
+        return std::make_shared<const PacketSendInfo>(std::move(info));
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    template<StaticPacketConcept<TPacketID> T>
+    typename Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Frame_ptr Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::MakeFrame(const T& packet)
+    {
+        PacketSendInfo info = PacketSendInfo::NewFrame(static_cast<uint8_t>(static_cast<TPacketID>(T::s_ID)), {}, StaticPacketMaxSize<T>());
+
+        // Qualified call, no virtual dispatch even when `T` derives from `IPacket`
+        packet.T::Write(info.Body);
+
+        // Too big for a single frame, sent in fragments
+        if(info.Body.size() <= PacketBuffer::MaxSize)
+            info.SealFrame();
+
+        return std::make_shared<const PacketSendInfo>(std::move(info));
     }
 
     template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
@@ -438,40 +1800,168 @@ namespace AWEngine::Packet::Util
             }
         }
 
-        PacketSendInfo info = {};
-        info.Header.ID = packet.ID;
+        SendFrame(MakeFrame(packet));
+    }
 
-        packet.Write(info.Body);
-        info.Header.Size = htobe16(info.Body.size()); // Swap from local to network endian
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::SendFrame(Frame_ptr frame)
+    {
+        if(!IsConnected())
+            throw std::runtime_error("Not Connected - SendFrame(frame)");
 
-        if(m_Direction == PacketDirection::ToClient)
+        // Straight from this thread, nothing to keep in order with
+        if(IsUnreliable(frame))
+        {
+            SendDatagram(frame);
+            return;
+        }
+
+        // KeepAlive does not wait for `Flush` - timeouts must not depend on the game loop and RTT must not include the staging delay
+        bool keepAlive = frame->Header.ID == static_cast<uint8_t>(PacketID_KeepAlive);
+
+        // Big packets wait too, so they cannot overtake packets staged before them
+        if(m_DeferredSend && !keepAlive)
         {
-            if(info.Header.ID == PacketID_KeepAlive)
+            std::scoped_lock lock(m_StagedMutex);
+            m_Staged.emplace_back(std::move(frame));
+            StatMax(&TrafficStats::StagedHighWater, m_Staged.size());
+            return;
+        }
+
+        // Runs immediately when already called from the strand (e.g. Init sent from the connect handler)
+        // so it cannot be overtaken by packets posted from other threads meanwhile
+        asio::dispatch(
+            m_Strand,
+            [this, frame = std::move(frame), keepAlive]() mutable
             {
-                // Send back
-                if(info.Header.Flags == PacketFlags{} && info.Header.Size >= sizeof(uint64_t))
+                // Connection failed since the packet was sent
+                if(!m_Socket.is_open())
                 {
-                    m_LastKeepAliveValue = *reinterpret_cast<const uint64_t*>(info.Body.data());
+                    StatAdd(&TrafficStats::Drops, 1);
+                    return;
                 }
+
+                // Value the client has to send back, compared by `AddToIncomingMessageQueue` on this strand
+                if(keepAlive && m_Direction == PacketDirection::ToClient && frame->Header.Flags == PacketFlags{} && frame->Header.Size >= sizeof(uint64_t))
+                    std::memcpy(&m_LastKeepAliveValue, frame->Body.data(), sizeof(m_LastKeepAliveValue));
+
+                // If a message is in the process of asynchronously being written, the new one waits in the queue.
+                // Otherwise start the process of writing the message at the front of the queue.
+                QueueFrame(std::move(frame));
+                WriteNext();
             }
+        );
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::Flush()
+    {
+        std::vector<Frame_ptr> staged;
+        {
+            std::scoped_lock lock(m_StagedMutex);
+            if(m_Staged.empty())
+                return;
+            staged.swap(m_Staged);
         }
 
-        //TODO Compression
+        if(!IsConnected())
+        {
+            // Nothing to send them to
+            StatAdd(&TrafficStats::Drops, staged.size());
+            return;
+        }
 
-        asio::post(
-            m_IoContext,
-            [this, info]()
-            {
-                // If the queue has a message in it, then we must assume that it is in the process of asynchronously being written.
-                // Either way add the message to the queue to be output.
-                // If no messages were available to be written, then start the process of writing the message at the front of the queue.
-                bool bWritingMessage = !m_MessagesOut.empty();
-                m_MessagesOut.push_back(std::move(info));
-                if (!bWritingMessage)
+        asio::dispatch(
+            m_Strand,
+            [this, staged = std::move(staged)]() mutable
+            {
+                if(!m_Socket.is_open())
                 {
-                    WriteHeader();
+                    StatAdd(&TrafficStats::Drops, staged.size());
+                    return;
                 }
+
+                for(Frame_ptr& frame : staged)
+                    QueueFrame(std::move(frame));
+                WriteNext();
             }
         );
     }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::QueueFrame(Frame_ptr frame)
+    {
+        if(frame->Body.size() > PacketBuffer::MaxSize)
+        {
+            // Too big for a single frame, send in fragments.
+            // Body is shared, only the position is tracked per connection
+            std::shared_ptr<const PacketBuffer> body(frame, &frame->Body);
+            m_StreamsOut.push_back(OutgoingStream{ frame->Header.ID, m_NextStreamID++, std::move(body) });
+            return;
+        }
+
+        m_MessagesOut.push_back(std::move(frame));
+        StatMax(&TrafficStats::OutQueueHighWater, m_MessagesOut.size());
+    }
+
+#ifdef AWE_PACKET_COROUTINE
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    template<typename THandler>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::StartReceive(THandler&& handler)
+    {
+        // Packets of other connections are pushed to the incoming queue
+        if(!m_SessionMode || !m_ReceiveSlot.empty())
+        {
+            CompletionSlot<void(asio::error_code, PacketSendInfo)> rejected;
+            rejected.Set(std::move(handler), m_Strand);
+            rejected.Complete(m_SessionMode ? asio::error::in_progress : asio::error::operation_not_supported, PacketSendInfo{});
+            return;
+        }
+
+        m_ReceiveSlot.Set(std::move(handler), m_Strand);
+        if(!m_Socket.is_open())
+        {
+            m_ReceiveSlot.Complete(asio::error::not_connected, PacketSendInfo{});
+            return;
+        }
+
+        ContinueReading();
+    }
+
+    template<typename TPacketID, TPacketID PacketID_KeepAlive, TPacketID PacketID_Init>
+    template<typename THandler>
+    void Connection<TPacketID, PacketID_KeepAlive, PacketID_Init>::StartSend(THandler&& handler, Frame_ptr frame)
+    {
+        if(!m_SendSlot.empty())
+        {
+            CompletionSlot<void(asio::error_code)> busy;
+            busy.Set(std::move(handler), m_Strand);
+            busy.Complete(asio::error::in_progress);
+            return;
+        }
+
+        m_SendSlot.Set(std::move(handler), m_Strand);
+        if(!m_Socket.is_open())
+        {
+            StatAdd(&TrafficStats::Drops, 1);
+            m_SendSlot.Complete(asio::error::not_connected);
+            return;
+        }
+
+        if(frame->Body.size() > PacketBuffer::MaxSize)
+        {
+            // Completed by the last fragment, see `NextFragment`
+            std::shared_ptr<const PacketBuffer> body(frame, &frame->Body);
+            m_SendWaiter = body.get();
+            m_StreamsOut.push_back(OutgoingStream{ frame->Header.ID, m_NextStreamID++, std::move(body) });
+        }
+        else
+        {
+            m_SendWaiter = frame.get();
+            m_MessagesOut.push_back(std::move(frame));
+            StatMax(&TrafficStats::OutQueueHighWater, m_MessagesOut.size());
+        }
+        WriteNext();
+    }
+#endif
 }
@@ -0,0 +1,34 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstdint>
+#include <functional>
+
+#include "SlotMap.hpp"
+
+namespace AWEngine::Packet::Util
+{
+    /// Handle of a client connected to `PacketServer`.
+    /// Cheap to copy and store, stays detectably invalid after the client disconnects (see `PacketServer::Find`).
+    struct ConnectionId
+    {
+        /// Index of `ServerShard` owning the connection
+        uint32_t   Shard = 0;
+        /// Position in connections of the shard
+        SlotMapKey Key   = {};
+
+        [[nodiscard]] inline bool IsNull() const noexcept { return Key.IsNull(); }
+
+        [[nodiscard]] inline bool operator==(const ConnectionId& other) const noexcept { return Shard == other.Shard && Key == other.Key; }
+        [[nodiscard]] inline bool operator!=(const ConnectionId& other) const noexcept { return !(*this == other); }
+    };
+}
+
+template<>
+struct std::hash<AWEngine::Packet::Util::ConnectionId>
+{
+    std::size_t operator()(const AWEngine::Packet::Util::ConnectionId& id) const noexcept
+    {
+        return std::hash<AWEngine::Packet::Util::SlotMapKey>()(id.Key) ^ (static_cast<std::size_t>(id.Shard) * 0x9E3779B97F4A7C15ull);
+    }
+};
@@ -0,0 +1,225 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+
+#include <asio.hpp>
+
+#include "AWEngine/Packet/IPacket.hpp"
+#include "AWEngine/Packet/PacketBuffer.hpp"
+#include "AWEngine/Packet/ProtocolInfo.hpp"
+#include "ConnectionId.hpp"
+
+// Unreliable side channel (UDP) of a connection, for packets where only the newest one matters (positions, inputs).
+// A lost TCP segment delays every later packet until it is resent, a lost datagram delays nothing.
+//
+// 1. Server accepts `Init` with `NextInitStep::Join` and sends a packet with ID of `Init` (the `PacketID_Init` of `Connection`) and `PacketFlags::Datagram` over TCP, body is `DatagramOffer`.
+// 2. Client sends hello datagrams (header only) to the offered port until the server answers with a hello.
+//    Server learns the address of the client from the first datagram with correct token.
+// 3. Both sides send packets listed in `DatagramOptions::Unreliable` as datagrams - `DatagramHeader` followed by the frame (header + body).
+//    Received ones have `PacketFlags::Datagram` set, older than the last accepted one of the same packet ID are discarded.
+// Until the hello is answered (or when UDP is blocked), and for packets not fitting into `MaxDatagramSize`, TCP is used.
+
+namespace AWEngine::Packet::Util
+{
+    /// Bigger datagrams could be fragmented by IP (any lost part loses the whole datagram), bigger packets go over TCP
+    static const constexpr std::size_t MaxDatagramSize = 1200;
+
+    /// Which packets use the side channel, both sides need the same list
+    struct DatagramOptions
+    {
+        /// Server: open UDP socket on the same port and offer the channel to every joining client.
+        /// Client: accept the offer.
+        bool             Enabled       = false;
+        /// IDs of packets sent as datagrams
+        std::bitset<256> Unreliable    = {};
+        /// Fraction (0-1) of outgoing datagrams dropped on purpose, to see how the game copes with a bad network
+        double           SimulatedLoss = 0.0;
+
+        template<typename TPacketID>
+        inline DatagramOptions& SetUnreliable(TPacketID id, bool unreliable = true)
+        {
+            Unreliable.set(static_cast<uint8_t>(id), unreliable);
+            return *this;
+        }
+        template<typename TPacketID>
+        [[nodiscard]] inline bool IsUnreliable(TPacketID id) const { return Unreliable.test(static_cast<uint8_t>(id)); }
+    };
+
+    /// Start of every datagram (little endian, like packet bodies).
+    /// Datagram without packet after the header is a hello.
+    struct DatagramHeader
+    {
+        static const constexpr std::size_t Size = 3 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+
+        /// Connection of the client on the server
+        ConnectionId Id       = {};
+        /// Secret from `DatagramOffer`, only the client connected over TCP knows it
+        uint64_t     Token    = 0;
+        /// Increases with every datagram of the sender
+        uint32_t     Sequence = 0;
+
+        inline void Write(uint8_t* out) const noexcept
+        {
+            uint32_t shard      = htole32(Id.Shard);
+            uint32_t index      = htole32(Id.Key.Index);
+            uint32_t generation = htole32(Id.Key.Generation);
+            uint64_t token      = htole64(Token);
+            uint32_t sequence   = htole32(Sequence);
+            std::memcpy(out,      &shard,      sizeof(shard));
+            std::memcpy(out + 4,  &index,      sizeof(index));
+            std::memcpy(out + 8,  &generation, sizeof(generation));
+            std::memcpy(out + 12, &token,      sizeof(token));
+            std::memcpy(out + 20, &sequence,   sizeof(sequence));
+        }
+        [[nodiscard]] static inline DatagramHeader Read(const uint8_t* in) noexcept
+        {
+            uint32_t shard, index, generation, sequence;
+            uint64_t token;
+            std::memcpy(&shard,      in,      sizeof(shard));
+            std::memcpy(&index,      in + 4,  sizeof(index));
+            std::memcpy(&generation, in + 8,  sizeof(generation));
+            std::memcpy(&token,      in + 12, sizeof(token));
+            std::memcpy(&sequence,   in + 20, sizeof(sequence));
+
+            DatagramHeader header;
+            header.Id       = ConnectionId{ le32toh(shard), SlotMapKey{ le32toh(index), le32toh(generation) } };
+            header.Token    = le64toh(token);
+            header.Sequence = le32toh(sequence);
+            return header;
+        }
+    };
+
+    /// Received datagram, points into the receive buffer
+    struct DatagramView
+    {
+        static const constexpr std::size_t FrameHeaderSize = sizeof(PacketHeader<uint8_t>);
+
+        DatagramHeader Header    = {};
+        /// Packet as a frame (header in network format + body), empty for hello
+        const uint8_t* Frame     = nullptr;
+        std::size_t    FrameSize = 0;
+
+        [[nodiscard]] inline bool IsHello() const noexcept { return FrameSize == 0; }
+
+        /// Nothing when the datagram is malformed
+        [[nodiscard]] static std::optional<DatagramView> Parse(const uint8_t* data, std::size_t size) noexcept
+        {
+            if(size < DatagramHeader::Size || size > MaxDatagramSize)
+                return std::nullopt;
+
+            DatagramView view;
+            view.Header    = DatagramHeader::Read(data);
+            view.Frame     = data + DatagramHeader::Size;
+            view.FrameSize = size - DatagramHeader::Size;
+            if(view.IsHello())
+                return view;
+            if(view.FrameSize < FrameHeaderSize)
+                return std::nullopt;
+
+            // Fragments and compression never go over the side channel
+            if(view.Frame[1] != 0)
+                return std::nullopt;
+            uint16_t bodySize;
+            std::memcpy(&bodySize, view.Frame + 2, sizeof(bodySize));
+            if(be16toh(bodySize) != view.FrameSize - FrameHeaderSize)
+                return std::nullopt;
+
+            return view;
+        }
+    };
+
+    /// Body of `Init` packet with `PacketFlags::Datagram`, consumed by the client connection
+    struct DatagramOffer
+    {
+        ConnectionId Id    = {};
+        uint64_t     Token = 0;
+        /// UDP port of the server, the address is the one of the TCP connection
+        uint16_t     Port  = 0;
+
+        inline void Write(PacketBuffer& out) const
+        {
+            out << Id.Shard << Id.Key.Index << Id.Key.Generation << Token << Port;
+        }
+        [[nodiscard]] static inline DatagramOffer Read(PacketBuffer& in)
+        {
+            DatagramOffer offer;
+            in >> offer.Id.Shard >> offer.Id.Key.Index >> offer.Id.Key.Generation >> offer.Token >> offer.Port;
+            return offer;
+        }
+    };
+
+    /// Discards datagrams older than the newest accepted one of the same packet ID (e.g. position overtaken by a newer position)
+    class DatagramSequenceFilter
+    {
+    private:
+        std::array<uint32_t, 256> m_Last = {};
+        std::bitset<256>          m_Seen = {};
+
+    public:
+        [[nodiscard]] inline bool Accept(uint8_t id, uint32_t sequence) noexcept
+        {
+            // Wrap-around aware, sequence 2^31 ahead is considered old
+            if(m_Seen.test(id) && static_cast<int32_t>(sequence - m_Last[id]) <= 0)
+                return false;
+
+            m_Seen.set(id);
+            m_Last[id] = sequence;
+            return true;
+        }
+    };
+
+    /// UDP socket of the side channel - shared by all connections of a server, owned by a single connection of a client.
+    /// Sends are non-blocking from any thread, datagram which does not fit into the send buffer is dropped like one lost on the way.
+    class DatagramSocket : public ::AWEngine::Packet::NoCopyOrMove
+    {
+    public:
+        DatagramSocket(asio::io_context& context, double simulatedLoss)
+            : Socket(context),
+              m_SimulatedLoss(simulatedLoss)
+        {
+        }
+
+    public:
+        asio::ip::udp::socket Socket;
+
+    private:
+        double m_SimulatedLoss;
+        /// Per sending thread, only used with `m_SimulatedLoss`
+        [[nodiscard]] static inline std::mt19937& Random()
+        {
+            thread_local std::mt19937 random(std::random_device{}());
+            return random;
+        }
+
+    public:
+        /// Open and switch to non-blocking mode, port 0 = any
+        inline void Open(const asio::ip::udp::endpoint& local)
+        {
+            Socket.open(local.protocol());
+            Socket.bind(local);
+            Socket.non_blocking(true);
+        }
+
+        /// False when the datagram could not be sent (dropped on purpose counts as sent).
+        /// Called from any thread without locking, each call is a single non-blocking `sendto`.
+        inline bool SendTo(const asio::ip::udp::endpoint& to, const DatagramHeader& header, asio::const_buffer frame)
+        {
+            uint8_t raw[DatagramHeader::Size];
+            header.Write(raw);
+            std::array<asio::const_buffer, 2> buffers = { asio::buffer(raw), frame };
+
+            if(m_SimulatedLoss > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(Random()) < m_SimulatedLoss)
+                return true;
+
+            asio::error_code ec;
+            Socket.send_to(buffers, to, 0, ec);
+            return !ec;
+        }
+    };
+}
@@ -0,0 +1,191 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace AWEngine::Packet::Util
+{
+    /// Threads processing batches of tasks, the calling thread takes part too.
+    /// Every worker has its own queue, a worker without tasks steals from the back of queues of others.
+    /// A single task is always processed by a single thread from start to end, different tasks run in parallel in no particular order.
+    /// Work which must stay in order belongs to one task - e.g. one task per connection keeps messages of that connection in order.
+    template<typename TTask>
+    class DispatchPool : public ::AWEngine::Packet::NoCopyOrMove
+    {
+    public:
+        /// Called with the task and index of the worker processing it (the thread calling `Run` is the last one)
+        typedef std::function<void(TTask&, std::size_t worker)> Handler_t;
+
+    public:
+        /// `threadCount` threads in addition to the one calling `Run`
+        DispatchPool(std::size_t threadCount, Handler_t handler)
+            : m_Handler(std::move(handler))
+        {
+            if(!m_Handler)
+                throw std::runtime_error("No handler provided");
+
+            for(std::size_t i = 0; i < threadCount + 1; i++)
+                m_Workers.emplace_back(std::make_unique<Worker>());
+
+            m_Threads.reserve(threadCount);
+            for(std::size_t i = 0; i < threadCount; i++)
+                m_Threads.emplace_back([this, i]() { ThreadMain(i); });
+        }
+        ~DispatchPool()
+        {
+            {
+                std::scoped_lock lock(m_StateMutex);
+                m_Stopping = true;
+            }
+            m_Start.notify_all();
+
+            for(std::thread& thread : m_Threads)
+                if(thread.joinable())
+                    thread.join();
+        }
+
+    private:
+        struct Worker
+        {
+            std::mutex        Mutex = {};
+            std::deque<TTask> Tasks = {};
+        };
+
+    private:
+        Handler_t                            m_Handler;
+        /// Last one belongs to the thread calling `Run`
+        std::vector<std::unique_ptr<Worker>> m_Workers = {};
+        std::vector<std::thread>             m_Threads = {};
+
+        /// Guards `m_Generation`, `m_Stopping` and `m_Error`
+        std::mutex              m_StateMutex = {};
+        std::condition_variable m_Start      = {};
+        std::condition_variable m_Done       = {};
+        /// Increased by every `Run` to wake the threads
+        uint64_t                m_Generation = 0;
+        bool                    m_Stopping   = false;
+        /// First exception thrown by the handler during current `Run`
+        std::exception_ptr      m_Error      = nullptr;
+        /// Pushed tasks not finished yet
+        std::atomic<std::size_t> m_Pending   = 0;
+
+    public:
+        /// Including the thread calling `Run`
+        [[nodiscard]] inline std::size_t WorkerCount() const noexcept { return m_Workers.size(); }
+
+    public:
+        /// Queue task for worker `worker % WorkerCount()`.
+        /// Call from the thread calling `Run`, tasks may start before `Run` when threads are still busy with previous batch.
+        inline void Push(std::size_t worker, TTask task)
+        {
+            m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+            Worker& target = *m_Workers[worker % m_Workers.size()];
+            std::scoped_lock lock(target.Mutex);
+            target.Tasks.emplace_back(std::move(task));
+        }
+
+        /// Process all pushed tasks and wait until they are finished (barrier).
+        /// Rethrows first exception thrown by the handler.
+        inline void Run()
+        {
+            if(m_Pending.load(std::memory_order_acquire) == 0)
+                return;
+
+            {
+                std::scoped_lock lock(m_StateMutex);
+                m_Generation++;
+            }
+            m_Start.notify_all();
+
+            Work(m_Workers.size() - 1);
+
+            std::exception_ptr error;
+            {
+                std::unique_lock<std::mutex> lock(m_StateMutex);
+                m_Done.wait(lock, [this]() { return m_Pending.load(std::memory_order_acquire) == 0; });
+                std::swap(error, m_Error);
+            }
+            if(error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+        /// Own tasks from the front, tasks of others from the back
+        inline bool TryPop(std::size_t self, TTask& out)
+        {
+            for(std::size_t offset = 0; offset < m_Workers.size(); offset++)
+            {
+                Worker& worker = *m_Workers[(self + offset) % m_Workers.size()];
+                std::scoped_lock lock(worker.Mutex);
+                if(worker.Tasks.empty())
+                    continue;
+
+                if(offset == 0)
+                {
+                    out = std::move(worker.Tasks.front());
+                    worker.Tasks.pop_front();
+                }
+                else
+                {
+                    out = std::move(worker.Tasks.back());
+                    worker.Tasks.pop_back();
+                }
+                return true;
+            }
+            return false;
+        }
+
+        /// Process tasks until there are none left
+        inline void Work(std::size_t self)
+        {
+            TTask task;
+            while(TryPop(self, task))
+            {
+                try
+                {
+                    m_Handler(task, self);
+                }
+                catch(...)
+                {
+                    std::scoped_lock lock(m_StateMutex);
+                    if(!m_Error)
+                        m_Error = std::current_exception();
+                }
+                task = {};
+
+                if(m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    std::scoped_lock lock(m_StateMutex);
+                    m_Done.notify_all();
+                }
+            }
+        }
+
+        inline void ThreadMain(std::size_t self)
+        {
+            uint64_t generation = 0;
+            while(true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_StateMutex);
+                    m_Start.wait(lock, [&]() { return m_Stopping || m_Generation != generation; });
+                    if(m_Stopping)
+                        return;
+                    generation = m_Generation;
+                }
+
+                Work(self);
+            }
+        }
+    };
+}
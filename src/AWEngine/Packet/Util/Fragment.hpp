@@ -0,0 +1,65 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstdint>
+#include <memory>
+
+#include "AWEngine/Packet/PacketBuffer.hpp"
+#include "AWEngine/Packet/ProtocolInfo.hpp"
+
+namespace AWEngine::Packet::Util
+{
+    /// Body of a packet with `PacketFlags::Fragment` starts with:
+    /// - `uint16_t` stream ID (unique among unfinished streams of the sender)
+    /// - `uint8_t`  `FragmentKind`
+    /// - `uint64_t` total size of the original body (only in the first fragment)
+    /// followed by the next part of the original body.
+    AWE_ENUM_FLAGS(FragmentKind, uint8_t)
+    {
+        Middle = 0,
+        First  = 1u << 0u,
+        Last   = 1u << 1u
+    };
+
+    /// Size of fragment header inside body of the packet
+    static const constexpr std::size_t FragmentHeaderSize      = sizeof(uint16_t) + sizeof(uint8_t);
+    static const constexpr std::size_t FragmentFirstHeaderSize = FragmentHeaderSize + sizeof(uint64_t);
+
+    /// Part of a packet which was too big for a single frame.
+    /// Only valid during the callback, copy the data to keep them.
+    struct StreamChunk
+    {
+        /// ID of the original packet
+        uint8_t        ID;
+        uint16_t       StreamID;
+        /// Size of the whole original body
+        uint64_t       TotalSize;
+        /// Position of `Data` inside the original body
+        uint64_t       Offset;
+        const uint8_t* Data;
+        uint32_t       Size;
+
+        [[nodiscard]] inline bool IsFirst() const noexcept { return Offset == 0; }
+        [[nodiscard]] inline bool IsLast()  const noexcept { return Offset + Size == TotalSize; }
+    };
+
+    /// Oversized body being sent in fragments
+    struct OutgoingStream
+    {
+        uint8_t                             ID;
+        uint16_t                            StreamID;
+        /// Shared with other connections when broadcasting
+        std::shared_ptr<const PacketBuffer> Body;
+        std::size_t                         Offset = 0;
+    };
+
+    /// Oversized body being received in fragments
+    struct IncomingStream
+    {
+        uint8_t      ID;
+        uint64_t     TotalSize;
+        uint64_t     Received = 0;
+        /// Empty when chunks are passed to a callback instead
+        PacketBuffer Body     = {};
+    };
+}
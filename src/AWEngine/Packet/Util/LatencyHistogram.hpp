@@ -0,0 +1,168 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+
+namespace AWEngine::Packet::Util
+{
+    /// Fixed-size log-linear histogram of durations.
+    /// Values are bucketed by microseconds, every power-of-two range is split into `SubBucketCount` linear buckets
+    /// so the relative error of a percentile is at most 1/`SubBucketCount` (~6%).
+    /// Values above ~67 seconds fall into the last bucket.
+    /// Recording is thread-safe and lock-free, reading is safe from any thread but not an atomic snapshot.
+    class LatencyHistogram
+    {
+    public:
+        static const constexpr uint32_t SubBucketBits  = 4;
+        static const constexpr uint32_t SubBucketCount = 1u << SubBucketBits;
+        /// Highest power of two (of microseconds) with its own buckets
+        static const constexpr uint32_t MaxExponent    = 26;
+        static const constexpr uint32_t BucketCount    = SubBucketCount + (MaxExponent - SubBucketBits + 1) * SubBucketCount;
+
+    public:
+        LatencyHistogram() = default;
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    private:
+        std::array<std::atomic<uint32_t>, BucketCount> m_Buckets = {};
+        std::atomic<uint64_t>                          m_Count   = 0;
+
+    public:
+        [[nodiscard]] inline uint64_t Count() const noexcept { return m_Count.load(std::memory_order_relaxed); }
+
+    public:
+        [[nodiscard]] static constexpr uint32_t BucketIndex(uint64_t microseconds) noexcept
+        {
+            if(microseconds < SubBucketCount)
+                return static_cast<uint32_t>(microseconds);
+
+            uint32_t exponent = std::bit_width(microseconds) - 1; // >= SubBucketBits
+            if(exponent > MaxExponent)
+                return BucketCount - 1;
+
+            uint32_t shift = exponent - SubBucketBits;
+            uint32_t sub   = static_cast<uint32_t>(microseconds >> shift) & (SubBucketCount - 1);
+            return SubBucketCount + shift * SubBucketCount + sub;
+        }
+        /// Highest value (in microseconds) which falls into the bucket
+        [[nodiscard]] static constexpr uint64_t BucketUpperBound(uint32_t index) noexcept
+        {
+            if(index < SubBucketCount)
+                return index;
+
+            uint32_t shift = (index - SubBucketCount) / SubBucketCount;
+            uint64_t sub   = (index - SubBucketCount) % SubBucketCount;
+            return ((SubBucketCount + sub + 1) << shift) - 1;
+        }
+
+    public:
+        inline void Record(std::chrono::nanoseconds value) noexcept
+        {
+            auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(value).count();
+            if(microseconds < 0)
+                microseconds = 0;
+
+            m_Buckets[BucketIndex(static_cast<uint64_t>(microseconds))].fetch_add(1, std::memory_order_relaxed);
+            m_Count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Value below which `quantile` (0.0 - 1.0) of recorded values are.
+        /// Returns zero when nothing was recorded.
+        [[nodiscard]] inline std::chrono::nanoseconds Percentile(double quantile) const noexcept
+        {
+            uint64_t count = Count();
+            if(count == 0)
+                return std::chrono::nanoseconds::zero();
+
+            if(quantile < 0.0)
+                quantile = 0.0;
+            else if(quantile > 1.0)
+                quantile = 1.0;
+
+            auto target = static_cast<uint64_t>(quantile * static_cast<double>(count));
+            if(target == 0)
+                target = 1;
+
+            uint64_t seen = 0;
+            for(uint32_t i = 0; i < BucketCount; i++)
+            {
+                seen += m_Buckets[i].load(std::memory_order_relaxed);
+                if(seen >= target)
+                    return std::chrono::microseconds(BucketUpperBound(i));
+            }
+            return std::chrono::microseconds(BucketUpperBound(BucketCount - 1));
+        }
+
+        /// Add all values recorded by `other`
+        inline void Merge(const LatencyHistogram& other) noexcept
+        {
+            for(uint32_t i = 0; i < BucketCount; i++)
+                m_Buckets[i].fetch_add(other.m_Buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            m_Count.fetch_add(other.Count(), std::memory_order_relaxed);
+        }
+
+        inline void Reset() noexcept
+        {
+            for(auto& bucket : m_Buckets)
+                bucket.store(0, std::memory_order_relaxed);
+            m_Count.store(0, std::memory_order_relaxed);
+        }
+    };
+    static_assert(LatencyHistogram::BucketIndex(LatencyHistogram::BucketUpperBound(100)) == 100);
+
+    /// Round-trip time statistics of a single connection.
+    /// Smoothed RTT and jitter follow RFC 6298 (gains 1/8 and 1/4).
+    /// Written only by the network thread of the connection, readable from any thread.
+    class RttStats
+    {
+    public:
+        RttStats() = default;
+
+        RttStats(const RttStats&) = delete;
+        RttStats& operator=(const RttStats&) = delete;
+
+    private:
+        LatencyHistogram     m_Histogram = {};
+        std::atomic<int64_t> m_Last      = 0;
+        std::atomic<int64_t> m_Smoothed  = 0;
+        std::atomic<int64_t> m_Jitter    = 0;
+
+    public:
+        [[nodiscard]] inline const LatencyHistogram& Histogram() const noexcept { return m_Histogram; }
+        [[nodiscard]] inline uint64_t                 Count()     const noexcept { return m_Histogram.Count(); }
+        [[nodiscard]] inline std::chrono::nanoseconds Last()      const noexcept { return std::chrono::nanoseconds(m_Last.load(std::memory_order_relaxed)); }
+        [[nodiscard]] inline std::chrono::nanoseconds Smoothed()  const noexcept { return std::chrono::nanoseconds(m_Smoothed.load(std::memory_order_relaxed)); }
+        [[nodiscard]] inline std::chrono::nanoseconds Jitter()    const noexcept { return std::chrono::nanoseconds(m_Jitter.load(std::memory_order_relaxed)); }
+        [[nodiscard]] inline std::chrono::nanoseconds P50()       const noexcept { return m_Histogram.Percentile(0.50); }
+        [[nodiscard]] inline std::chrono::nanoseconds P99()       const noexcept { return m_Histogram.Percentile(0.99); }
+
+    public:
+        inline void Record(std::chrono::nanoseconds rtt) noexcept
+        {
+            int64_t sample = rtt.count();
+            if(m_Histogram.Count() == 0)
+            {
+                m_Smoothed.store(sample, std::memory_order_relaxed);
+                m_Jitter.store(sample / 2, std::memory_order_relaxed);
+            }
+            else
+            {
+                int64_t smoothed = m_Smoothed.load(std::memory_order_relaxed);
+                int64_t jitter   = m_Jitter.load(std::memory_order_relaxed);
+                int64_t error    = sample - smoothed;
+
+                m_Jitter.store(jitter + ((error < 0 ? -error : error) - jitter) / 4, std::memory_order_relaxed);
+                m_Smoothed.store(smoothed + error / 8, std::memory_order_relaxed);
+            }
+            m_Last.store(sample, std::memory_order_relaxed);
+
+            m_Histogram.Record(rtt);
+        }
+    };
+}
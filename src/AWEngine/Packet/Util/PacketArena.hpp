@@ -0,0 +1,116 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AWEngine::Packet::Util
+{
+    /// Monotonic allocator for objects living until the end of a batch (e.g. packets decoded during `PacketServer::Update`).
+    /// Memory is never returned to the system, `Reset` only rewinds so a warmed-up arena does not allocate at all.
+    /// Reset costs O(1) plus destructor call of every object which is not trivially destructible.
+    /// Not thread-safe.
+    class PacketArena : public ::AWEngine::Packet::NoCopy
+    {
+    public:
+        static const constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+    public:
+        explicit PacketArena(std::size_t blockSize = DefaultBlockSize)
+            : m_BlockSize(blockSize)
+        {
+        }
+        ~PacketArena()
+        {
+            Reset();
+        }
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> Data;
+            std::size_t                  Size;
+        };
+        struct Destructor
+        {
+            void (*Destroy)(void* object);
+            void* Object;
+        };
+
+    private:
+        std::size_t             m_BlockSize;
+        std::vector<Block>      m_Blocks      = {};
+        /// Block being allocated from
+        std::size_t             m_Block       = 0;
+        /// Used bytes of `m_Block`
+        std::size_t             m_Offset      = 0;
+        /// Objects to destroy on `Reset`, in order of creation
+        std::vector<Destructor> m_Destructors = {};
+        std::size_t             m_ObjectCount = 0;
+
+    public:
+        /// Objects created since last `Reset`
+        [[nodiscard]] inline std::size_t ObjectCount() const noexcept { return m_ObjectCount; }
+        /// Bytes owned by the arena
+        [[nodiscard]] inline std::size_t Capacity() const noexcept
+        {
+            std::size_t capacity = 0;
+            for(const Block& block : m_Blocks)
+                capacity += block.Size;
+            return capacity;
+        }
+
+    public:
+        /// Uninitialized memory valid until `Reset`
+        [[nodiscard]] inline void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t))
+        {
+            while(m_Block < m_Blocks.size())
+            {
+                Block&      block   = m_Blocks[m_Block];
+                std::size_t aligned = (m_Offset + alignment - 1) & ~(alignment - 1);
+                if(aligned + size <= block.Size)
+                {
+                    m_Offset = aligned + size;
+                    return block.Data.get() + aligned;
+                }
+
+                // Rest of the block is wasted until `Reset`
+                m_Block++;
+                m_Offset = 0;
+            }
+
+            std::size_t blockSize = std::max(m_BlockSize, size + alignment);
+            m_Blocks.push_back({ std::make_unique<std::byte[]>(blockSize), blockSize });
+            m_Block = m_Blocks.size() - 1;
+            return Allocate(size, alignment);
+        }
+
+        /// Object valid until `Reset`
+        template<typename T, typename... TArgs>
+        [[nodiscard]] inline T* Create(TArgs&&... args)
+        {
+            T* object = new(Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+            if constexpr(!std::is_trivially_destructible_v<T>)
+                m_Destructors.push_back({ [](void* ptr) { static_cast<T*>(ptr)->~T(); }, object });
+            m_ObjectCount++;
+            return object;
+        }
+
+        /// Destroy all objects and make the memory available again
+        inline void Reset() noexcept
+        {
+            for(auto it = m_Destructors.rbegin(); it != m_Destructors.rend(); ++it)
+                it->Destroy(it->Object);
+            m_Destructors.clear();
+
+            m_Block       = 0;
+            m_Offset      = 0;
+            m_ObjectCount = 0;
+        }
+    };
+}
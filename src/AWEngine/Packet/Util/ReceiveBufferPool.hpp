@@ -0,0 +1,68 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <asio.hpp>
+
+#include "AWEngine/Packet/PacketBuffer.hpp"
+
+namespace AWEngine::Packet::Util
+{
+    /// Receive buffers of connections of a single asio context, allocated at once.
+    /// A connection with a slot reads as much as the socket has into it and cuts the packets out (see `Connection::SetReceiveBuffer`),
+    /// many small packets cost a single read instead of two per packet.
+    class ReceiveBufferPool : public ::AWEngine::Packet::NoCopyOrMove
+    {
+    public:
+        /// Fits the biggest frame (header + `PacketBuffer::MaxSize`)
+        static const constexpr std::size_t SlotSize = 64 * 1024;
+        static_assert(SlotSize >= sizeof(PacketHeader<uint8_t>) + PacketBuffer::MaxSize);
+
+    public:
+        explicit ReceiveBufferPool(std::size_t slotCount)
+            : m_Storage(std::make_unique<uint8_t[]>(slotCount * SlotSize))
+        {
+            m_Free.reserve(slotCount);
+            for(std::size_t i = slotCount; i > 0; i--)
+                m_Free.emplace_back(i - 1);
+        }
+
+    private:
+        std::unique_ptr<uint8_t[]> m_Storage;
+        /// Indexes of free slots, lowest at the back
+        std::vector<std::size_t>   m_Free  = {};
+        /// Guards `m_Free`, slots are taken by accepting thread and returned by whichever thread destroys the connection
+        std::mutex                 m_Mutex = {};
+
+    public:
+        /// Index of a free slot, none when all are used
+        [[nodiscard]] inline std::optional<std::size_t> Acquire()
+        {
+            std::scoped_lock lock(m_Mutex);
+            if(m_Free.empty())
+                return std::nullopt;
+
+            std::size_t slot = m_Free.back();
+            m_Free.pop_back();
+            return slot;
+        }
+        inline void Release(std::size_t slot)
+        {
+            std::scoped_lock lock(m_Mutex);
+            m_Free.emplace_back(slot);
+        }
+
+    public:
+        [[nodiscard]] inline uint8_t* Data(std::size_t slot) const noexcept { return m_Storage.get() + slot * SlotSize; }
+        /// Part of slot from `offset` to its end
+        [[nodiscard]] inline asio::mutable_buffer Buffer(std::size_t slot, std::size_t offset)
+        {
+            return asio::buffer(Data(slot) + offset, SlotSize - offset);
+        }
+    };
+}
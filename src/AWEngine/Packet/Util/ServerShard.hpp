@@ -0,0 +1,91 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <asio.hpp>
+
+#include "ThreadSafeQueue.hpp"
+#include "LatencyHistogram.hpp"
+#include "TrafficStats.hpp"
+#include "SlotMap.hpp"
+#include "TimerWheel.hpp"
+#include "CoarseClock.hpp"
+#include "ReceiveBufferPool.hpp"
+
+namespace AWEngine::Packet::Util
+{
+#if defined(SO_REUSEPORT)
+    /// Multiple sockets can listen on the same port, the system balances new connections between them
+    typedef asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT> ReusePort;
+    static const constexpr bool ReusePortSupported = true;
+#else
+    static const constexpr bool ReusePortSupported = false;
+#endif
+
+    /// Independent part of a server - own asio context, acceptor, network threads, connections and received messages.
+    /// Network threads of a shard never touch data of other shards.
+    template<typename TConnection>
+    struct ServerShard : public ::AWEngine::Packet::NoCopy
+    {
+    public:
+        typedef std::shared_ptr<TConnection>         Connection_ptr;
+        typedef typename TConnection::OwnedMessage_t OwnedMessage_t;
+
+    public:
+        explicit ServerShard(std::size_t index)
+            : Index(index)
+        {
+        }
+
+    public:
+        const std::size_t Index;
+
+        // Order of declaration is important - it is also the order of initialisation
+        // Connections (and their strands) must be destroyed before the context
+        asio::io_context IoContext = {};
+
+        /// Received messages waiting for `PacketServer::Update`
+        ThreadSafeQueue<OwnedMessage_t> MessageInQueue = {};
+        /// Messages taken from `MessageInQueue` all at once and not processed yet (over the limit of `PacketServer::Update`).
+        /// Older than anything in `MessageInQueue`, only accessed by the thread calling `PacketServer::Update`.
+        std::deque<OwnedMessage_t>      MessageBatch   = {};
+
+        /// Active validated connections accepted by this shard, see `ConnectionId`
+        SlotMap<Connection_ptr> Connections      = {};
+        /// Guards `Connections`, new clients are added from network threads of the shard
+        std::mutex              ConnectionsMutex = {};
+
+        std::vector<std::thread> Threads = {};
+
+        /// Not open when the shard receives connections accepted by another shard (no SO_REUSEPORT)
+        asio::ip::tcp::acceptor                       Acceptor     = asio::ip::tcp::acceptor(IoContext);
+        /// Serializes handlers of pending accepts of `Acceptor`
+        asio::strand<asio::io_context::executor_type> AcceptStrand = asio::make_strand(IoContext);
+
+        /// Round-trip times of connections of this shard
+        LatencyHistogram Latency = {};
+        /// Sum of traffic of connections of this shard
+        TrafficStats     Traffic = {};
+
+        /// Timeout checks of connections (handshake, idle, keep-alive), only accessed from `TimerStrand`
+        TimerWheel<SlotMapKey>                        Timers      = {};
+        asio::strand<asio::io_context::executor_type> TimerStrand = asio::make_strand(IoContext);
+        /// Advances `Timers` every `PacketServerConfiguration::TimeoutResolution`
+        asio::steady_timer                            TimerTick   = asio::steady_timer(TimerStrand);
+        /// Time of tick 0 of `Timers`
+        CoarseClock::time_point                       TimerEpoch  = {};
+        /// Timers expired in current tick, reused
+        std::vector<SlotMapKey>                       Expired     = {};
+
+        /// Connections removed by timeout checks, waiting for `PacketServer::Update` to let the user know
+        ThreadSafeQueue<Connection_ptr> Removed = {};
+
+        /// Receive buffers of connections of this shard, see `PacketServerConfiguration::ReceiveBuffers`
+        std::shared_ptr<ReceiveBufferPool> ReceiveBuffers = nullptr;
+    };
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace AWEngine::Packet::Util
+{
+    /// Handle to a value in `SlotMap`.
+    /// Stays detectably invalid after the value is removed even when its slot is reused.
+    struct SlotMapKey
+    {
+        static const constexpr uint32_t InvalidIndex = (std::numeric_limits<uint32_t>::max)();
+
+        uint32_t Index      = InvalidIndex;
+        uint32_t Generation = 0;
+
+        [[nodiscard]] inline bool IsNull() const noexcept { return Index == InvalidIndex; }
+
+        [[nodiscard]] inline bool operator==(const SlotMapKey& other) const noexcept { return Index == other.Index && Generation == other.Generation; }
+        [[nodiscard]] inline bool operator!=(const SlotMapKey& other) const noexcept { return !(*this == other); }
+    };
+
+    /// Container with O(1) insert, remove and lookup by generational key.
+    /// Values are stored densely (in no particular order) so iteration is as fast as over `std::vector`.
+    /// Removing a value moves the last one into its place, iterators and pointers are invalidated by insert and remove.
+    template<typename T>
+    class SlotMap
+    {
+    public:
+        typedef SlotMapKey Key;
+
+        typedef typename std::vector<T>::iterator       iterator;
+        typedef typename std::vector<T>::const_iterator const_iterator;
+
+    private:
+        struct Slot
+        {
+            /// Position in `m_Values` when occupied, next free slot when free
+            uint32_t DenseIndex;
+            /// Increased on every remove so old keys do not match
+            uint32_t Generation;
+        };
+
+    private:
+        std::vector<T>        m_Values     = {};
+        /// Slot of value at the same position in `m_Values`
+        std::vector<uint32_t> m_ValueSlots = {};
+        std::vector<Slot>     m_Slots      = {};
+        uint32_t              m_FreeSlot   = Key::InvalidIndex;
+
+    public:
+        [[nodiscard]] inline std::size_t size()  const noexcept { return m_Values.size(); }
+        [[nodiscard]] inline bool        empty() const noexcept { return m_Values.empty(); }
+
+        [[nodiscard]] inline iterator       begin()       noexcept { return m_Values.begin(); }
+        [[nodiscard]] inline iterator       end()         noexcept { return m_Values.end(); }
+        [[nodiscard]] inline const_iterator begin() const noexcept { return m_Values.begin(); }
+        [[nodiscard]] inline const_iterator end()   const noexcept { return m_Values.end(); }
+
+        /// Key of value at position `denseIndex` of iteration
+        [[nodiscard]] inline Key KeyAt(std::size_t denseIndex) const noexcept
+        {
+            uint32_t slot = m_ValueSlots[denseIndex];
+            return { slot, m_Slots[slot].Generation };
+        }
+
+    public:
+        inline Key Insert(T value)
+        {
+            if(m_Values.size() >= Key::InvalidIndex)
+                throw std::runtime_error("SlotMap is full");
+
+            uint32_t slot;
+            if(m_FreeSlot != Key::InvalidIndex)
+            {
+                slot       = m_FreeSlot;
+                m_FreeSlot = m_Slots[slot].DenseIndex;
+            }
+            else
+            {
+                slot = static_cast<uint32_t>(m_Slots.size());
+                m_Slots.push_back({ 0, 1 });
+            }
+
+            m_Slots[slot].DenseIndex = static_cast<uint32_t>(m_Values.size());
+            m_Values.emplace_back(std::move(value));
+            m_ValueSlots.emplace_back(slot);
+
+            return { slot, m_Slots[slot].Generation };
+        }
+
+        /// Returns false when the key is not valid (anymore)
+        inline bool Erase(Key key)
+        {
+            if(!Contains(key))
+                return false;
+
+            Slot&    slot       = m_Slots[key.Index];
+            uint32_t denseIndex = slot.DenseIndex;
+            uint32_t lastIndex  = static_cast<uint32_t>(m_Values.size() - 1);
+            if(denseIndex != lastIndex)
+            {
+                m_Values[denseIndex]     = std::move(m_Values[lastIndex]);
+                m_ValueSlots[denseIndex] = m_ValueSlots[lastIndex];
+                m_Slots[m_ValueSlots[denseIndex]].DenseIndex = denseIndex;
+            }
+            m_Values.pop_back();
+            m_ValueSlots.pop_back();
+
+            slot.Generation++;
+            slot.DenseIndex = m_FreeSlot;
+            m_FreeSlot      = key.Index;
+            return true;
+        }
+
+        /// Remove all values matching `predicate`
+        template<typename TPredicate>
+        inline std::size_t EraseIf(TPredicate predicate)
+        {
+            std::size_t erased = 0;
+            for(std::size_t i = 0; i < m_Values.size();)
+            {
+                if(predicate(m_Values[i]))
+                {
+                    Erase(KeyAt(i)); // Last value moves to `i`
+                    erased++;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+            return erased;
+        }
+
+        inline void clear() noexcept
+        {
+            for(uint32_t slot : m_ValueSlots)
+            {
+                m_Slots[slot].Generation++;
+                m_Slots[slot].DenseIndex = m_FreeSlot;
+                m_FreeSlot = slot;
+            }
+            m_Values.clear();
+            m_ValueSlots.clear();
+        }
+
+    public:
+        /// Safe for any key, including ones received from network (free slot with matching generation does not count)
+        [[nodiscard]] inline bool Contains(Key key) const noexcept
+        {
+            if(key.Index >= m_Slots.size())
+                return false;
+
+            const Slot& slot = m_Slots[key.Index];
+            return slot.Generation == key.Generation && slot.DenseIndex < m_ValueSlots.size() && m_ValueSlots[slot.DenseIndex] == key.Index;
+        }
+        /// Returns `nullptr` when the key is not valid (anymore)
+        [[nodiscard]] inline T* Find(Key key) noexcept
+        {
+            return Contains(key) ? &m_Values[m_Slots[key.Index].DenseIndex] : nullptr;
+        }
+        /// Returns `nullptr` when the key is not valid (anymore)
+        [[nodiscard]] inline const T* Find(Key key) const noexcept
+        {
+            return Contains(key) ? &m_Values[m_Slots[key.Index].DenseIndex] : nullptr;
+        }
+    };
+}
+
+template<>
+struct std::hash<AWEngine::Packet::Util::SlotMapKey>
+{
+    std::size_t operator()(const AWEngine::Packet::Util::SlotMapKey& key) const noexcept
+    {
+        return std::hash<uint64_t>()((static_cast<uint64_t>(key.Generation) << 32u) | key.Index);
+    }
+};
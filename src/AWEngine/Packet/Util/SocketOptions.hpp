@@ -0,0 +1,94 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <iostream>
+
+#include <asio.hpp>
+
+#if defined(__linux__)
+#   include <netinet/in.h>
+#   include <netinet/tcp.h>
+#   include <sys/socket.h>
+#   include <linux/errqueue.h>
+#endif
+
+namespace AWEngine::Packet::Util
+{
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+    /// Sending straight from user memory with completion reported on the error queue of the socket (Linux 4.14+)
+    static const constexpr bool ZeroCopySupported = true;
+#else
+    static const constexpr bool ZeroCopySupported = false;
+#endif
+
+    /// Options applied to a TCP socket right after the connection is established
+    /// (except `ReceiveBufferSize`, see `ApplyPreConnectSocketOptions`).
+    /// Value `0` keeps the system default.
+    struct SocketOptions
+    {
+        /// Disable Nagle's algorithm (TCP_NODELAY).
+        /// Without it, small writes may be held back by the kernel until previous data are acknowledged by the remote side.
+        bool NoDelay = true;
+        /// Size of the kernel send buffer in bytes (SO_SNDBUF).
+        int SendBufferSize = 0;
+        /// Size of the kernel receive buffer in bytes (SO_RCVBUF).
+        /// Set before the TCP handshake - window scale is negotiated there, bigger buffer set later cannot be fully used.
+        int ReceiveBufferSize = 0;
+        /// Acknowledge received data immediately instead of delaying the ACK (TCP_QUICKACK).
+        /// Linux only, ignored elsewhere.
+        /// The kernel may leave quick-ack mode on its own so treat it as a hint.
+        bool QuickAck = false;
+        /// Maximum time in milliseconds sent data may stay unacknowledged before the connection is dropped (TCP_USER_TIMEOUT).
+        /// Linux only, ignored elsewhere.
+        unsigned int UserTimeout = 0;
+    };
+
+    /// Apply options which must be set before the TCP handshake (SO_RCVBUF) to open but not connected `socket`,
+    /// or to listening `socket` before `listen` - accepted sockets inherit them.
+    /// Failure to set an option is reported to `std::cerr`.
+    template<typename TSocket>
+    inline void ApplyPreConnectSocketOptions(TSocket& socket, const SocketOptions& options)
+    {
+        if(options.ReceiveBufferSize > 0)
+        {
+            asio::error_code ec;
+            socket.set_option(asio::socket_base::receive_buffer_size(options.ReceiveBufferSize), ec);
+            if(ec)
+                std::cerr << "Failed to set SO_RCVBUF: " << ec.value() << " - " << ec.message() << std::endl;
+        }
+    }
+
+    /// Apply `options` to connected `socket`, except those of `ApplyPreConnectSocketOptions`.
+    /// Failure to set an option is reported to `std::cerr` but does not close the socket.
+    inline void ApplySocketOptions(asio::ip::tcp::socket& socket, const SocketOptions& options)
+    {
+        asio::error_code ec;
+
+        socket.set_option(asio::ip::tcp::no_delay(options.NoDelay), ec);
+        if(ec)
+            std::cerr << "Failed to set TCP_NODELAY: " << ec.value() << " - " << ec.message() << std::endl;
+
+        if(options.SendBufferSize > 0)
+        {
+            socket.set_option(asio::socket_base::send_buffer_size(options.SendBufferSize), ec);
+            if(ec)
+                std::cerr << "Failed to set SO_SNDBUF: " << ec.value() << " - " << ec.message() << std::endl;
+        }
+
+#if defined(__linux__)
+        if(options.QuickAck)
+        {
+            socket.set_option(asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true), ec);
+            if(ec)
+                std::cerr << "Failed to set TCP_QUICKACK: " << ec.value() << " - " << ec.message() << std::endl;
+        }
+
+        if(options.UserTimeout > 0)
+        {
+            socket.set_option(asio::detail::socket_option::integer<IPPROTO_TCP, TCP_USER_TIMEOUT>(static_cast<int>(options.UserTimeout)), ec);
+            if(ec)
+                std::cerr << "Failed to set TCP_USER_TIMEOUT: " << ec.value() << " - " << ec.message() << std::endl;
+        }
+#endif
+    }
+}
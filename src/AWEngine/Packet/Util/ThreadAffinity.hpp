@@ -0,0 +1,38 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <cstddef>
+#include <thread>
+
+#if defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+#elif defined(_WIN32)
+#   include <windows.h>
+#endif
+
+namespace AWEngine::Packet::Util
+{
+    /// Restrict current thread to run only on CPU core `core` (modulo number of cores).
+    /// Returns false when not supported or refused by the system, the thread keeps running anywhere in that case.
+    inline bool PinCurrentThread(std::size_t core) noexcept
+    {
+        std::size_t coreCount = std::thread::hardware_concurrency();
+        if(coreCount == 0)
+            return false;
+        core %= coreCount;
+
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+        if(core >= sizeof(DWORD_PTR) * 8)
+            return false;
+        return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) != 0;
+#else
+        return false;
+#endif
+    }
+}
@@ -3,9 +3,104 @@
 #include <mutex>
 #include <deque> // double-ended <queue>
 #include <condition_variable>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace AWEngine::Packet::Util
 {
+    /// Wakes threads waiting for an item, may be shared by multiple queues to wait for an item in any of them (see `ThreadSafeQueue::set_signal`).
+    /// `Notify` takes no lock and makes no system call unless somebody waits.
+    /// Waiting compares the sequence number atomically with going to sleep (futex on Linux) so a push right after checking the queue is never missed.
+    class QueueSignal
+    {
+    public:
+        QueueSignal() = default;
+        QueueSignal(const QueueSignal&) = delete;
+        QueueSignal& operator=(const QueueSignal&) = delete;
+
+    private:
+        /// Increased by every `Notify`
+        std::atomic<uint32_t> m_Sequence = 0;
+        std::atomic<uint32_t> m_Waiters  = 0;
+#if defined(__linux__)
+        static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free, "futex needs plain 32-bit word");
+#else
+        std::mutex              m_Mutex  = {};
+        std::condition_variable m_Pushed = {};
+#endif
+
+    public:
+        /// Read before checking the condition and pass it to `WaitUntil`
+        [[nodiscard]] inline uint32_t Sequence() const noexcept { return m_Sequence.load(std::memory_order_seq_cst); }
+
+        inline void Notify() noexcept
+        {
+            m_Sequence.fetch_add(1, std::memory_order_seq_cst);
+            if(m_Waiters.load(std::memory_order_seq_cst) == 0)
+                return;
+
+#if defined(__linux__)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_Sequence), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+            {
+                // Waiter is either sleeping or did not check the sequence yet
+                std::scoped_lock lock(m_Mutex);
+            }
+            m_Pushed.notify_all();
+#endif
+        }
+
+        /// Sleep until `Notify` is called after `sequence` was read or until `deadline`.
+        /// Returns false on timeout, may return true spuriously - check the condition again.
+        inline bool WaitUntil(uint32_t sequence, std::chrono::steady_clock::time_point deadline)
+        {
+            bool notified = true;
+            m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+#if defined(__linux__)
+            if(m_Sequence.load(std::memory_order_seq_cst) == sequence)
+            {
+                // FUTEX_WAIT_BITSET takes absolute time of CLOCK_MONOTONIC (same as steady_clock)
+                timespec  time    = {};
+                timespec* timeout = nullptr;
+                if(deadline != std::chrono::steady_clock::time_point::max())
+                {
+                    auto sinceEpoch = (std::max)(deadline.time_since_epoch(), std::chrono::steady_clock::duration::zero());
+                    auto seconds    = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+                    time.tv_sec  = static_cast<time_t>(seconds.count());
+                    time.tv_nsec = static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch - seconds).count());
+                    timeout = &time;
+                }
+
+                if(syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_Sequence), FUTEX_WAIT_BITSET_PRIVATE, sequence, timeout, nullptr, FUTEX_BITSET_MATCH_ANY) != 0)
+                    notified = errno != ETIMEDOUT; // EAGAIN = notified before sleeping, EINTR = spurious
+            }
+#else
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                auto changed = [&]() { return m_Sequence.load(std::memory_order_seq_cst) != sequence; };
+                if(deadline == std::chrono::steady_clock::time_point::max())
+                    m_Pushed.wait(lock, changed);
+                else
+                    notified = m_Pushed.wait_until(lock, deadline, changed);
+            }
+#endif
+            m_Waiters.fetch_sub(1, std::memory_order_seq_cst);
+            return notified;
+        }
+    };
+
     template<typename T>
     class ThreadSafeQueue
     {
@@ -28,12 +123,26 @@ namespace AWEngine::Packet::Util
         std::deque<T> m_Data = {};
 
     private:
-        /// Gets set when item is pushed
+        /// Notified when item is pushed
         /// For wait()
-        std::condition_variable m_ItemPushed;
-        /// Mutex lock for wait()
-        /// Locked in push_*() procedures
-        std::mutex m_MutexItemPushed = {};
+        QueueSignal m_ItemPushed = {};
+        /// Also notified when the queue stops being empty, optional
+        QueueSignal* m_Signal = nullptr;
+
+        inline void notify(bool wasEmpty)
+        {
+            m_ItemPushed.Notify();
+            // Waiter sleeps only after seeing the queue empty, the push which ended that is enough to wake it
+            if(m_Signal && wasEmpty)
+                m_Signal->Notify();
+        }
+
+    public:
+        /// Notify `signal` when an item is pushed into empty queue, in addition to `wait()` notified on every push.
+        /// Pushes behind other items do not touch `signal` so queues of different threads sharing it stay independent under load.
+        /// The queue is not locked while notifying so waiting on `signal` can check the queue.
+        /// Only set before the queue is used.
+        inline void set_signal(QueueSignal* signal) noexcept { m_Signal = signal; }
 
     public:
         /// Read the first item without removing it from the queue
@@ -67,46 +176,77 @@ namespace AWEngine::Packet::Util
             return std::move(t);
         }
 
+        /// Move all items to the end of `out` under a single lock.
+        /// When `out` is empty, the containers are only swapped.
+        /// Returns number of moved items.
+        inline size_t pop_all(std::deque<T>& out)
+        {
+            std::scoped_lock lock(m_MutesQueue);
+            size_t count = m_Data.size();
+            if(out.empty())
+            {
+                out.swap(m_Data);
+            }
+            else
+            {
+                std::move(m_Data.begin(), m_Data.end(), std::back_inserter(out));
+                m_Data.clear();
+            }
+            return count;
+        }
+
     public:
         /// Add item to start
         template<std::enable_if_t<std::is_move_constructible<T>::value, bool> = true>
         inline void push_front(const T& item)
         {
-            std::scoped_lock lock(m_MutesQueue);
-            m_Data.push_front(item);
+            bool wasEmpty;
+            {
+                std::scoped_lock lock(m_MutesQueue);
+                wasEmpty = m_Data.empty();
+                m_Data.push_front(item);
+            }
 
-            std::unique_lock<std::mutex> ul(m_MutexItemPushed);
-            m_ItemPushed.notify_one();
+            notify(wasEmpty);
         }
         /// Add item to start
         template<std::enable_if_t<std::is_move_constructible<T>::value, bool> = false>
         inline void push_front(T&& item)
         {
-            std::scoped_lock lock(m_MutesQueue);
-            m_Data.push_front(std::forward<T>(item));
+            bool wasEmpty;
+            {
+                std::scoped_lock lock(m_MutesQueue);
+                wasEmpty = m_Data.empty();
+                m_Data.push_front(std::forward<T>(item));
+            }
 
-            std::unique_lock<std::mutex> ul(m_MutexItemPushed);
-            m_ItemPushed.notify_one();
+            notify(wasEmpty);
         }
         /// Add item to end
         template<std::enable_if_t<std::is_move_constructible<T>::value, bool> = true>
         inline void push_back(const T& item)
         {
-            std::scoped_lock lock(m_MutesQueue);
-            m_Data.push_back(item);
+            bool wasEmpty;
+            {
+                std::scoped_lock lock(m_MutesQueue);
+                wasEmpty = m_Data.empty();
+                m_Data.push_back(item);
+            }
 
-            std::unique_lock<std::mutex> ul(m_MutexItemPushed);
-            m_ItemPushed.notify_one();
+            notify(wasEmpty);
         }
         /// Add item to end
         template<std::enable_if_t<std::is_move_constructible<T>::value, bool> = false>
         inline void push_back(T&& item)
         {
-            std::scoped_lock lock(m_MutesQueue);
-            m_Data.push_back(std::forward<T>(item));
+            bool wasEmpty;
+            {
+                std::scoped_lock lock(m_MutesQueue);
+                wasEmpty = m_Data.empty();
+                m_Data.push_back(std::forward<T>(item));
+            }
 
-            std::unique_lock<std::mutex> ul(m_MutexItemPushed);
-            m_ItemPushed.notify_one();
+            notify(wasEmpty);
         }
 
     public:
@@ -134,11 +274,27 @@ namespace AWEngine::Packet::Util
         /// Blocks current thread
         inline void wait()
         {
-            while (empty())
+            wait_until(std::chrono::steady_clock::time_point::max());
+        }
+        /// Wait until there is an item or `deadline` passes.
+        /// Returns false when the queue is still empty.
+        inline bool wait_until(std::chrono::steady_clock::time_point deadline)
+        {
+            while(true)
             {
-                std::unique_lock<std::mutex> ul(m_MutexItemPushed);
-                m_ItemPushed.wait(ul);
+                // Read before checking so a push in between wakes the wait below
+                uint32_t sequence = m_ItemPushed.Sequence();
+                if(!empty())
+                    return true;
+                if(!m_ItemPushed.WaitUntil(sequence, deadline))
+                    return !empty();
             }
         }
+        /// Wait until there is an item or `timeout` passes.
+        /// Returns false when the queue is still empty.
+        inline bool wait_for(std::chrono::steady_clock::duration timeout)
+        {
+            return wait_until(std::chrono::steady_clock::now() + timeout);
+        }
     };
 }
@@ -0,0 +1,123 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace AWEngine::Packet::Util
+{
+    /// Hierarchical timer wheel - scheduling is O(1) and `Advance` costs O(1) per tick plus O(expiring).
+    /// Time is measured in ticks, the owner decides how long a tick is.
+    /// Timers cannot be cancelled, the owner should check whether an expired timer is still relevant (and schedule it again when not yet).
+    /// Not thread-safe.
+    template<typename T>
+    class TimerWheel
+    {
+    public:
+        static const constexpr std::size_t SlotBits   = 6;
+        static const constexpr std::size_t SlotCount  = std::size_t(1) << SlotBits;
+        static const constexpr std::size_t LevelCount = 4;
+        /// Timers further in the future are kept in the last level until they get close enough
+        static const constexpr uint64_t    MaxDelay   = (uint64_t(1) << (SlotBits * LevelCount)) - 1;
+
+    private:
+        struct Entry
+        {
+            uint64_t Deadline;
+            T        Value;
+        };
+
+    private:
+        std::array<std::array<std::vector<Entry>, SlotCount>, LevelCount> m_Slots = {};
+        /// Last processed tick
+        uint64_t    m_Now  = 0;
+        std::size_t m_Size = 0;
+
+    public:
+        [[nodiscard]] inline uint64_t    Now()   const noexcept { return m_Now; }
+        [[nodiscard]] inline std::size_t size()  const noexcept { return m_Size; }
+        [[nodiscard]] inline bool        empty() const noexcept { return m_Size == 0; }
+
+    public:
+        /// Timers with deadline not after `Now()` expire on the next tick
+        inline void Schedule(uint64_t deadline, T value)
+        {
+            Place({ deadline, std::move(value) }, m_Now + 1);
+            m_Size++;
+        }
+
+        /// Process all ticks up to `tick` (including), `onExpired(T&&)` is called for every expired timer.
+        /// It may schedule new timers.
+        /// Returns number of expired timers.
+        template<typename TCallback>
+        inline std::size_t Advance(uint64_t tick, TCallback&& onExpired)
+        {
+            std::size_t expired = 0;
+            while(m_Now < tick)
+            {
+                m_Now++;
+
+                // Move timers of upper levels closer as their slot comes up, top-down so they can still land in the current tick
+                std::size_t cascadeLevels = 1;
+                while(cascadeLevels < LevelCount && (m_Now & ((uint64_t(1) << (SlotBits * cascadeLevels)) - 1)) == 0)
+                    cascadeLevels++;
+                for(std::size_t level = cascadeLevels - 1; level > 0; level--)
+                {
+                    std::vector<Entry> cascade;
+                    cascade.swap(m_Slots[level][SlotIndex(m_Now, level)]);
+                    for(Entry& entry : cascade)
+                        Place(std::move(entry), m_Now);
+                }
+
+                std::vector<Entry> slot;
+                slot.swap(m_Slots[0][SlotIndex(m_Now, 0)]);
+                for(Entry& entry : slot)
+                {
+                    if(entry.Deadline > m_Now) // Clamped to `MaxDelay`
+                    {
+                        Place(std::move(entry), m_Now + 1);
+                        continue;
+                    }
+
+                    m_Size--;
+                    expired++;
+                    onExpired(std::move(entry.Value));
+                }
+            }
+            return expired;
+        }
+
+        inline void clear() noexcept
+        {
+            for(auto& level : m_Slots)
+                for(auto& slot : level)
+                    slot.clear();
+            m_Size = 0;
+        }
+
+    private:
+        [[nodiscard]] static inline std::size_t SlotIndex(uint64_t tick, std::size_t level) noexcept
+        {
+            return static_cast<std::size_t>(tick >> (SlotBits * level)) & (SlotCount - 1);
+        }
+
+        /// `earliest` is the first tick whose slot was not processed yet
+        inline void Place(Entry&& entry, uint64_t earliest)
+        {
+            uint64_t deadline = entry.Deadline;
+            if(deadline < earliest)
+                deadline = earliest;
+            if(deadline - m_Now > MaxDelay)
+                deadline = m_Now + MaxDelay;
+
+            // Lowest level which covers the delay
+            uint64_t    delay = deadline - m_Now;
+            std::size_t level = 0;
+            while(level + 1 < LevelCount && delay >= (uint64_t(1) << (SlotBits * (level + 1))))
+                level++;
+
+            m_Slots[level][SlotIndex(deadline, level)].emplace_back(std::move(entry));
+        }
+    };
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "AWEngine/Packet/Util/Core_Packet.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace AWEngine::Packet::Util
+{
+    /// Plain copy of `TrafficStats`.
+    struct TrafficStatsSnapshot
+    {
+        uint64_t BytesIn    = 0;
+        uint64_t BytesOut   = 0;
+        uint64_t PacketsIn  = 0;
+        uint64_t PacketsOut = 0;
+        /// Highest number of packets waiting in the outgoing queue
+        uint64_t OutQueueHighWater    = 0;
+        /// Highest number of packets staged for `Flush` (deferred send)
+        uint64_t StagedHighWater      = 0;
+        /// Highest number of received packets waiting for `Update`
+        uint64_t PendingInHighWater   = 0;
+        /// Outgoing packets discarded because the connection failed
+        uint64_t Drops       = 0;
+        /// How many times reading was paused because too many received packets were waiting for `Update`
+        uint64_t ReadsPaused = 0;
+        /// Connections refused because the server was full (server only)
+        uint64_t Rejected    = 0;
+        /// Packets sent without copying into the kernel (MSG_ZEROCOPY)
+        uint64_t ZeroCopySends  = 0;
+        /// Zero-copy send calls the kernel reported as copied anyway (e.g. over loopback)
+        uint64_t ZeroCopyCopied = 0;
+        /// Packets received over the unreliable side channel (see `Util/Datagram.hpp`)
+        uint64_t DatagramsIn    = 0;
+        /// Packets sent over the unreliable side channel, including those lost on the way
+        uint64_t DatagramsOut   = 0;
+        /// Received datagrams discarded as older than an already received packet of the same ID
+        uint64_t DatagramsStale = 0;
+
+        /// Combine with stats of another connection or shard (counters are summed, high-water marks use maximum)
+        inline TrafficStatsSnapshot& operator+=(const TrafficStatsSnapshot& other) noexcept
+        {
+            BytesIn    += other.BytesIn;
+            BytesOut   += other.BytesOut;
+            PacketsIn  += other.PacketsIn;
+            PacketsOut += other.PacketsOut;
+            OutQueueHighWater  = (std::max)(OutQueueHighWater,  other.OutQueueHighWater);
+            StagedHighWater    = (std::max)(StagedHighWater,    other.StagedHighWater);
+            PendingInHighWater = (std::max)(PendingInHighWater, other.PendingInHighWater);
+            Drops       += other.Drops;
+            ReadsPaused += other.ReadsPaused;
+            Rejected    += other.Rejected;
+            ZeroCopySends  += other.ZeroCopySends;
+            ZeroCopyCopied += other.ZeroCopyCopied;
+            DatagramsIn    += other.DatagramsIn;
+            DatagramsOut   += other.DatagramsOut;
+            DatagramsStale += other.DatagramsStale;
+            return *this;
+        }
+    };
+
+    /// Traffic counters of a connection or aggregate of the whole server.
+    /// Updated by network threads with relaxed atomics so they can be read from any thread without locking.
+    /// Aligned to its own cache line to not slow down neighbouring data written by other threads.
+    struct alignas(64) TrafficStats
+    {
+    public:
+        TrafficStats() = default;
+
+        TrafficStats(const TrafficStats&) = delete;
+        TrafficStats& operator=(const TrafficStats&) = delete;
+
+    public:
+        std::atomic<uint64_t> BytesIn            = 0;
+        std::atomic<uint64_t> BytesOut           = 0;
+        std::atomic<uint64_t> PacketsIn          = 0;
+        std::atomic<uint64_t> PacketsOut         = 0;
+        std::atomic<uint64_t> OutQueueHighWater  = 0;
+        std::atomic<uint64_t> StagedHighWater    = 0;
+        std::atomic<uint64_t> PendingInHighWater = 0;
+        std::atomic<uint64_t> Drops              = 0;
+        std::atomic<uint64_t> ReadsPaused        = 0;
+        std::atomic<uint64_t> Rejected           = 0;
+        std::atomic<uint64_t> ZeroCopySends      = 0;
+        std::atomic<uint64_t> ZeroCopyCopied     = 0;
+        std::atomic<uint64_t> DatagramsIn        = 0;
+        std::atomic<uint64_t> DatagramsOut       = 0;
+        std::atomic<uint64_t> DatagramsStale     = 0;
+
+    public:
+        static inline void Add(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+        static inline void Max(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+        {
+            uint64_t previous = counter.load(std::memory_order_relaxed);
+            while(previous < value && !counter.compare_exchange_weak(previous, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+    public:
+        [[nodiscard]] inline TrafficStatsSnapshot Snapshot() const noexcept
+        {
+            return {
+                BytesIn.load(std::memory_order_relaxed),
+                BytesOut.load(std::memory_order_relaxed),
+                PacketsIn.load(std::memory_order_relaxed),
+                PacketsOut.load(std::memory_order_relaxed),
+                OutQueueHighWater.load(std::memory_order_relaxed),
+                StagedHighWater.load(std::memory_order_relaxed),
+                PendingInHighWater.load(std::memory_order_relaxed),
+                Drops.load(std::memory_order_relaxed),
+                ReadsPaused.load(std::memory_order_relaxed),
+                Rejected.load(std::memory_order_relaxed),
+                ZeroCopySends.load(std::memory_order_relaxed),
+                ZeroCopyCopied.load(std::memory_order_relaxed),
+                DatagramsIn.load(std::memory_order_relaxed),
+                DatagramsOut.load(std::memory_order_relaxed),
+                DatagramsStale.load(std::memory_order_relaxed)
+            };
+        }
+    };
+    static_assert(sizeof(TrafficStats) % 64 == 0);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+/// Like `assert` but never compiled out (`NDEBUG` of Release builds) - tests do their work inside the checks.
+/// Fails the test with the location and the condition.
+#define AWE_CHECK(...) \
+    do \
+    { \
+        if(!(__VA_ARGS__)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": Check failed: " << #__VA_ARGS__ << std::endl; \
+            std::abort(); \
+        } \
+    } while(false)
+
+/// Poll `predicate` until it holds or about 5 seconds pass, returns its last result.
+template<typename TPredicate>
+bool WaitFor(TPredicate predicate)
+{
+    for(int i = 0; i < 500 && !predicate(); i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return predicate();
+}
+
+/// Packet IDs of tests and benchmarks, each uses a few of the game ones.
+enum class PacketID : uint8_t
+{
+    Number   = 0u,
+    Position = 1u,
+    Snapshot = 2u,
+    Blob     = 3u,
+    Small    = 4u,
+    Big      = 5u,
+    MsgA     = 6u,
+    MsgB     = 7u,
+    MsgC     = 8u,
+    Move     = 9u,
+    Chat     = 10u,
+    Echo     = 11u,
+    Chunk    = 12u,
+    Jump     = 13u,
+
+    //----------------
+
+    Ping       = 0xF0u,
+    Pong       = Ping, // Can be same because of packet direction
+
+    Init       = 0xF1u,
+    ServerInfo = Init, // Can be same because of packet direction
+
+    Kick       = 0xFFu,
+    Disconnect = Kick // Can be same because of packet direction
+};
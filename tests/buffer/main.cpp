@@ -1,6 +1,6 @@
 #include <AWEngine/Packet/PacketBuffer.hpp>
 
-#include <cassert>
+#include "Check.hpp"
 
 int main(int argc, const char** argv)
 {
@@ -35,27 +35,27 @@ int main(int argc, const char** argv)
     std::cout << "size: " << pb.size() << std::endl;
 
     pb >> u8_ >> i8_;
-    assert(u8 == u8_);
-    assert(i8 == i8_);
+    AWE_CHECK(u8 == u8_);
+    AWE_CHECK(i8 == i8_);
 
     pb >> u16_ >> i16_;
-    assert(u16 == u16_);
-    assert(i16 == i16_);
+    AWE_CHECK(u16 == u16_);
+    AWE_CHECK(i16 == i16_);
 
     pb >> u32_ >> i32_;
-    assert(u32 == u32_);
-    assert(i32 == i32_);
+    AWE_CHECK(u32 == u32_);
+    AWE_CHECK(i32 == i32_);
 
     pb >> u64_ >> i64_;
-    assert(u64 == u64_);
-    assert(i64 == i64_);
+    AWE_CHECK(u64 == u64_);
+    AWE_CHECK(i64 == i64_);
 
     pb >> f_ >> d_;
-    assert(f == f_);
-    assert(d == d_);
+    AWE_CHECK(f == f_);
+    AWE_CHECK(d == d_);
 
     pb >> s_;
-    assert(s == s_);
+    AWE_CHECK(s == s_);
 
-    assert(pb.size() == 0);
+    AWE_CHECK(pb.size() == 0);
 }
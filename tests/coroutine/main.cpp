@@ -0,0 +1,163 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+#include "AWEngine/Packet/PacketClient.hpp"
+
+#include "Check.hpp"
+
+using namespace AWEngine::Packet;
+
+struct Number : public IPacket<PacketID>
+{
+    explicit Number(uint32_t value) : IPacket<PacketID>(PacketID::Number), Value(value) {}
+
+    uint32_t Value;
+
+    void Write(PacketBuffer& out) const override { out << Value; }
+};
+
+/// Too big for a single frame, sent in fragments
+struct Blob : public IPacket<PacketID>
+{
+    explicit Blob(std::size_t size) : IPacket<PacketID>(PacketID::Blob), Data(size, 0x5A) {}
+
+    std::vector<uint8_t> Data;
+
+    void Write(PacketBuffer& out) const override { out.Write(Data.size(), Data.data()); }
+};
+
+typedef PacketServer<PacketID, PacketID> PacketServer_t;
+typedef PacketClient<PacketID, PacketID> PacketClient_t;
+
+static const std::size_t ClientCount      = 4;
+static const uint32_t    PacketsPerClient = 200;
+static const std::size_t BlobSize         = 3 * PacketBuffer::MaxSize;
+
+std::atomic<std::size_t> g_Echoed        = 0;
+std::atomic<std::size_t> g_SessionsEnded = 0;
+std::atomic<bool>        g_AcceptAborted = false;
+
+/// Echo numbers in the order they arrive, answer the first one with a blob too
+asio::awaitable<void> Session(PacketServer_t::Connection_ptr connection)
+{
+    try
+    {
+        bool first = true;
+        while(true)
+        {
+            Util::PacketSendInfo msg = co_await connection->Receive();
+            if(msg.Header.ID == static_cast<uint8_t>(PacketID::Disconnect))
+                break;
+            AWE_CHECK(msg.Header.ID == static_cast<uint8_t>(PacketID::Number)); // KeepAlive and Init never reach the session
+
+            uint32_t value;
+            msg.Body >> value;
+            co_await connection->Send(Number(value), asio::use_awaitable);
+            if(first)
+            {
+                co_await connection->Send(Blob(BlobSize), asio::use_awaitable);
+                first = false;
+            }
+            g_Echoed++;
+        }
+    }
+    catch(const asio::system_error&)
+    {
+        // Connection closed without Disconnect
+    }
+    g_SessionsEnded++;
+}
+
+asio::awaitable<void> AcceptLoop(PacketServer_t& server)
+{
+    try
+    {
+        while(true)
+        {
+            PacketServer_t::Connection_ptr connection = co_await server.Accept();
+            AWE_CHECK(connection->IsSessionMode());
+            asio::co_spawn(connection->Strand(), Session(connection), asio::detached);
+        }
+    }
+    catch(const asio::system_error& ex)
+    {
+        g_AcceptAborted = ex.code() == asio::error::operation_aborted;
+    }
+}
+
+int main(int argc, const char** argv)
+{
+    PacketServerConfiguration config;
+    config.Port = 10140;
+    config.MaxPlayers = ClientCount;
+    config.CoroutineSessions = true;
+    config.ReceiveBuffers = ClientCount / 2; // Both ways of reading
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+
+    std::size_t updated = 0;
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr&, Util::PacketSendInfo&) { updated++; };
+    server.Start();
+
+    // Accepting coroutine runs in its own context
+    asio::io_context acceptContext;
+    asio::co_spawn(acceptContext, AcceptLoop(server), asio::detached);
+    std::thread acceptThread([&]() { acceptContext.run(); });
+
+    std::vector<std::unique_ptr<PacketClient_t>> clients;
+    for(std::size_t i = 0; i < ClientCount; i++)
+    {
+        clients.emplace_back(std::make_unique<PacketClient_t>("AWE_TST", 0));
+        clients.back()->Connect("localhost", config.Port);
+    }
+    for(auto& client : clients)
+        client->WaitForConnect();
+
+    for(uint32_t value = 0; value < PacketsPerClient; value++)
+        for(auto& client : clients)
+            client->Send(Number(value));
+
+    // Every client gets its numbers back in order, the blob after the first one
+    for(auto& client : clients)
+    {
+        AWE_CHECK(WaitFor([&]() { return client->Incoming().size() >= PacketsPerClient + 1; }));
+
+        uint32_t next = 0;
+        bool blob = false;
+        while(client->HasIncoming())
+        {
+            auto msg = client->Incoming().pop_front();
+            if(msg.second.Header.ID == static_cast<uint8_t>(PacketID::Blob))
+            {
+                AWE_CHECK(next == 1);
+                AWE_CHECK(msg.second.Body.size() == BlobSize);
+                blob = true;
+                continue;
+            }
+            if(msg.second.Header.ID != static_cast<uint8_t>(PacketID::Number))
+                continue;
+
+            uint32_t value;
+            msg.second.Body >> value;
+            AWE_CHECK(value == next);
+            next++;
+        }
+        AWE_CHECK(next == PacketsPerClient);
+        AWE_CHECK(blob);
+    }
+    AWE_CHECK(g_Echoed == ClientCount * PacketsPerClient);
+
+    // Sessions are served outside of `Update`
+    server.Update(-1, false);
+    AWE_CHECK(updated == 0);
+
+    // Receive fails once the client leaves
+    for(auto& client : clients)
+        client->Disconnect();
+    AWE_CHECK(WaitFor([]() { return g_SessionsEnded == ClientCount; }));
+
+    // Pending Accept fails when the server stops
+    server.Stop();
+    acceptThread.join();
+    AWE_CHECK(g_AcceptAborted);
+
+    std::cout << "Coroutine sessions OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,267 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+#include "AWEngine/Packet/PacketClient.hpp"
+
+#include "Check.hpp"
+
+using namespace AWEngine::Packet;
+
+/// Reliable
+struct Number : public IPacket<PacketID>
+{
+    explicit Number(uint32_t value) : IPacket<PacketID>(PacketID::Number), Value(value) {}
+
+    uint32_t Value;
+
+    void Write(PacketBuffer& out) const override { out << Value; }
+};
+
+/// Unreliable, only the newest one matters
+struct Position : public IPacket<PacketID>
+{
+    explicit Position(uint32_t tick) : IPacket<PacketID>(PacketID::Position), Tick(tick) {}
+
+    uint32_t Tick;
+
+    void Write(PacketBuffer& out) const override { out << Tick; }
+};
+
+/// Unreliable but too big for a datagram
+struct Snapshot : public IPacket<PacketID>
+{
+    Snapshot() : IPacket<PacketID>(PacketID::Snapshot) {}
+
+    void Write(PacketBuffer& out) const override
+    {
+        for(std::size_t i = 0; i < Util::MaxDatagramSize; i++)
+            out << static_cast<uint8_t>(i);
+    }
+};
+
+typedef PacketServer<PacketID, PacketID> PacketServer_t;
+typedef PacketClient<PacketID, PacketID> PacketClient_t;
+
+static const uint32_t    PacketCount = 1000;
+static const double      Loss        = 0.3;
+static const std::size_t MaxPending  = 64;
+
+/// Older datagrams of the same packet ID are discarded, other IDs are independent
+void TestSequenceFilter()
+{
+    Util::DatagramSequenceFilter filter;
+    AWE_CHECK(filter.Accept(1, 5));
+    AWE_CHECK(!filter.Accept(1, 5));
+    AWE_CHECK(!filter.Accept(1, 3));
+    AWE_CHECK(filter.Accept(2, 3));
+    AWE_CHECK(filter.Accept(1, 9));
+
+    // Sequence wraps around
+    AWE_CHECK(filter.Accept(3, 0xFFFFFFFEu));
+    AWE_CHECK(filter.Accept(3, 1));
+    AWE_CHECK(!filter.Accept(3, 0xFFFFFFFFu));
+}
+
+void TestParse()
+{
+    Util::DatagramHeader header;
+    header.Id       = Util::ConnectionId{ 2, Util::SlotMapKey{ 7, 3 } };
+    header.Token    = 0x0123456789ABCDEFull;
+    header.Sequence = 42;
+
+    // Hello
+    std::vector<uint8_t> data(Util::DatagramHeader::Size);
+    header.Write(data.data());
+    std::optional<Util::DatagramView> hello = Util::DatagramView::Parse(data.data(), data.size());
+    AWE_CHECK(hello && hello->IsHello());
+    AWE_CHECK(hello->Header.Id == header.Id && hello->Header.Token == header.Token && hello->Header.Sequence == header.Sequence);
+
+    // Packet
+    PacketServer_t::Frame_ptr frame = PacketServer_t::Connection_t::MakeFrame(Position(7));
+    const uint8_t* frameData = static_cast<const uint8_t*>(frame->Body.Frame().data());
+    data.insert(data.end(), frameData, frameData + frame->Body.Frame().size());
+    std::optional<Util::DatagramView> packet = Util::DatagramView::Parse(data.data(), data.size());
+    AWE_CHECK(packet && !packet->IsHello() && packet->FrameSize == frame->Body.Frame().size());
+
+    // Truncated, flags and too big
+    AWE_CHECK(!Util::DatagramView::Parse(data.data(), Util::DatagramHeader::Size - 1));
+    AWE_CHECK(!Util::DatagramView::Parse(data.data(), data.size() - 1));
+    data[Util::DatagramHeader::Size + 1] = static_cast<uint8_t>(PacketFlags::Fragment);
+    AWE_CHECK(!Util::DatagramView::Parse(data.data(), data.size()));
+    data.resize(Util::MaxDatagramSize + 1);
+    AWE_CHECK(!Util::DatagramView::Parse(data.data(), data.size()));
+}
+
+/// Positions go over UDP with simulated loss in both directions and arrive in order with gaps, everything else over TCP without gaps
+void TestLoopback(uint16_t port)
+{
+    Util::DatagramOptions options;
+    options.Enabled       = true;
+    options.SimulatedLoss = Loss;
+    options.SetUnreliable(PacketID::Position).SetUnreliable(PacketID::Snapshot);
+
+    PacketServerConfiguration config;
+    config.Port      = port;
+    config.Datagrams = options;
+    config.MaxPendingPacketsPerClient = MaxPending;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+
+    PacketServer_t::Connection_ptr connection;
+    uint32_t numbers   = 0;
+    uint32_t positions = 0;
+    uint32_t lastTick  = 0;
+    bool     inOrder   = true;
+    bool     snapshot  = false;
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr& client, Util::PacketSendInfo& info)
+    {
+        connection = client;
+        bool datagram = info.Header.Flags & PacketFlags::Datagram;
+        switch(static_cast<PacketID>(info.Header.ID))
+        {
+            case PacketID::Number:
+            {
+                AWE_CHECK(!datagram);
+                uint32_t value;
+                info.Body >> value;
+                inOrder &= value == numbers++;
+                break;
+            }
+            case PacketID::Position:
+            {
+                AWE_CHECK(datagram);
+                uint32_t tick;
+                info.Body >> tick;
+                inOrder &= positions == 0 || tick > lastTick;
+                lastTick = tick;
+                positions++;
+                break;
+            }
+            case PacketID::Snapshot:
+                AWE_CHECK(!datagram);
+                AWE_CHECK(info.Body.size() == Util::MaxDatagramSize);
+                snapshot = true;
+                break;
+            default:
+                break;
+        }
+    };
+    server.Start();
+
+    PacketClient_t client("AWE_TST", 0);
+    client.SetDatagramOptions(options);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+
+    // Hello is repeated until answered despite the loss
+    AWE_CHECK(WaitFor([&]() { server.Update(); return connection && connection->IsDatagramReady() && client.Connection().IsDatagramReady(); }));
+
+    // Client to server
+    for(uint32_t i = 1; i <= PacketCount; i++)
+    {
+        client.Send(Position(i));
+        client.Send(Number(i - 1));
+        if(i % 50 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    client.Send(Snapshot());
+    AWE_CHECK(WaitFor([&]() { server.Update(); return numbers == PacketCount && snapshot; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Datagrams may arrive after the last TCP packet
+    server.Update();
+    AWE_CHECK(inOrder);
+    AWE_CHECK(positions > 0 && positions < PacketCount);
+    AWE_CHECK(client.Connection().Stats().DatagramsOut.load() == PacketCount);
+    AWE_CHECK(server.TrafficSnapshot().DatagramsIn == positions);
+    // Datagrams cannot be paused like TCP, those over the limit of the client are dropped
+    AWE_CHECK(server.TrafficSnapshot().Drops > 0);
+
+    // Server to client
+    for(uint32_t i = 1; i <= PacketCount; i++)
+    {
+        server.Send(connection, Position(i));
+        if(i % 50 == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    server.Send(connection, Number(0));
+
+    // Number marks the end, datagrams may still arrive after it
+    uint32_t received = 0;
+    bool     done     = false;
+    lastTick = 0;
+    auto drain = [&]()
+    {
+        while(client.HasIncoming())
+        {
+            auto msg = client.Incoming().pop_front();
+            if(msg.second.Header.ID == static_cast<uint8_t>(PacketID::Number))
+                done = true;
+            if(msg.second.Header.ID != static_cast<uint8_t>(PacketID::Position))
+                continue;
+
+            AWE_CHECK(msg.second.Header.Flags & PacketFlags::Datagram);
+            uint32_t tick;
+            msg.second.Body >> tick;
+            AWE_CHECK(tick > lastTick);
+            lastTick = tick;
+            received++;
+        }
+        return done;
+    };
+    AWE_CHECK(WaitFor(drain));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    drain();
+    AWE_CHECK(received > 0 && received < PacketCount);
+    AWE_CHECK(client.Connection().Stats().DatagramsIn.load() == received);
+
+    // Forged datagrams are ignored - wrong token, free slot of a client which left, unknown slot and shard
+    std::mutex joinedMutex;
+    PacketServer_t::Connection_ptr joined;
+    Util::ConnectionId goneId;
+    server.OnClientConnect    = [&](const PacketServer_t::Connection_ptr& client) { std::scoped_lock lock(joinedMutex); joined = client; return true; };
+    server.OnClientDisconnect = [&](const PacketServer_t::Connection_ptr& client) { goneId = client->Id(); };
+    PacketClient_t gone("AWE_TST", 0);
+    gone.Connect("localhost", port);
+    gone.WaitForConnect();
+    AWE_CHECK(WaitFor([&]() { std::scoped_lock lock(joinedMutex); return joined && !joined->Id().Key.IsNull(); }));
+    joined->Disconnect();
+    AWE_CHECK(WaitFor([&]() { server.SendKeepAlive(); server.Update(); return !goneId.Key.IsNull(); }));
+    AWE_CHECK(!server.Find(goneId));
+
+    std::vector<Util::ConnectionId> forgedIds = {
+        connection->Id(),
+        Util::ConnectionId{ goneId.Shard, Util::SlotMapKey{ goneId.Key.Index, goneId.Key.Generation + 1 } },
+        Util::ConnectionId{ 0, Util::SlotMapKey{ 0, 2 } },
+        Util::ConnectionId{ 0, Util::SlotMapKey{ Util::SlotMapKey::InvalidIndex, 1 } },
+        Util::ConnectionId{ 1000, Util::SlotMapKey{ 0, 1 } },
+    };
+    asio::io_context context;
+    asio::ip::udp::socket forger(context, asio::ip::udp::endpoint(asio::ip::udp::v4(), 0));
+    PacketServer_t::Frame_ptr frame = PacketServer_t::Connection_t::MakeFrame(Position(PacketCount * 2));
+    for(const Util::ConnectionId& id : forgedIds)
+    {
+        Util::DatagramHeader forged;
+        forged.Id       = id;
+        forged.Token    = 12345;
+        forged.Sequence = PacketCount * 2;
+        uint8_t raw[Util::DatagramHeader::Size];
+        forged.Write(raw);
+        std::array<asio::const_buffer, 2> buffers = { asio::buffer(raw), frame->Body.Frame() };
+        forger.send_to(buffers, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), port));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint32_t before = positions;
+    server.Update();
+    AWE_CHECK(positions == before);
+
+    // Server still serves the real client
+    numbers = 0;
+    client.Send(Number(0));
+    AWE_CHECK(WaitFor([&]() { server.Update(); return numbers == 1; }));
+}
+
+int main(int argc, const char** argv)
+{
+    TestSequenceFilter();
+    TestParse();
+    TestLoopback(10141);
+
+    std::cout << "Datagram side channel OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+#include "AWEngine/Packet/PacketClient.hpp"
+
+#include "Check.hpp"
+
+using namespace AWEngine::Packet;
+
+struct Small : public IPacket<PacketID>
+{
+    Small() : IPacket<PacketID>(PacketID::Small) {}
+
+    void Write(PacketBuffer& out) const override { out << static_cast<uint32_t>(0xABCDu); }
+};
+
+/// Body of `Size` bytes, byte at index `i` has value `i % 251`
+struct Big : public IPacket<PacketID>
+{
+    explicit Big(std::size_t size) : IPacket<PacketID>(PacketID::Big), Size(size) {}
+
+    std::size_t Size;
+
+    void Write(PacketBuffer& out) const override
+    {
+        for(std::size_t i = 0; i < Size; i++)
+            out.Write(static_cast<uint8_t>(i % 251));
+    }
+};
+
+typedef PacketServer<PacketID, PacketID> PacketServer_t;
+typedef PacketClient<PacketID, PacketID> PacketClient_t;
+
+static const std::size_t BigSize = 1024 * 1024 + 13;
+
+int main(int argc, const char** argv)
+{
+    PacketServerConfiguration serverConfig;
+    serverConfig.Port = 10121;
+    serverConfig.FragmentSize = 4096;
+    serverConfig.DeferredSend = true;
+    serverConfig.AutoFlush    = false;
+
+    PacketServer_t server(serverConfig, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+
+    std::vector<uint8_t> receivedIDs;
+    std::size_t bigSize = 0;
+    bool bigValid = true;
+    PacketServer_t::Connection_ptr serverConnection;
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr& client, Util::PacketSendInfo& info)
+    {
+        serverConnection = client;
+        receivedIDs.emplace_back(info.Header.ID);
+        if(info.Header.ID == static_cast<uint8_t>(PacketID::Big))
+        {
+            AWE_CHECK(info.Header.Flags & PacketFlags::Fragment);
+            bigSize = info.Body.size();
+            for(std::size_t i = 0; i < info.Body.size(); i++)
+                bigValid &= info.Body[i] == i % 251;
+        }
+    };
+    server.Start();
+
+    PacketClient_t client("AWE_TST", 0);
+    std::size_t streamedSize = 0;
+    bool streamValid = true;
+    client.OnStreamChunk = [&](const Util::StreamChunk& chunk)
+    {
+        streamValid &= chunk.ID == static_cast<uint8_t>(PacketID::Big) && chunk.Offset == streamedSize && chunk.TotalSize == BigSize;
+        for(uint32_t i = 0; i < chunk.Size; i++)
+            streamValid &= chunk.Data[i] == (chunk.Offset + i) % 251;
+        streamedSize += chunk.Size;
+    };
+    client.Connect("localhost", serverConfig.Port);
+    client.WaitForConnect();
+
+    // Client -> Server, reassembled
+    // Both queued from the strand of the connection so the whole big packet cannot be written before the small one is queued
+    asio::post(client.Connection().Strand(), [&]()
+    {
+        client.Send(Big(BigSize));
+        client.Send(Small());
+    });
+    AWE_CHECK(WaitFor([&]() { server.Update(-1, false); return bigSize != 0; }));
+    AWE_CHECK(bigSize == BigSize);
+    AWE_CHECK(bigValid);
+
+    // Small packet did not wait for the whole big one
+    AWE_CHECK(receivedIDs.size() == 3); // Init, Small, Big
+    AWE_CHECK(receivedIDs[1] == static_cast<uint8_t>(PacketID::Small));
+    AWE_CHECK(receivedIDs[2] == static_cast<uint8_t>(PacketID::Big));
+
+    // Server -> Client, streamed
+    // Deferred - the big packet waits for `Flush` like the small one staged before it
+    serverConnection->Send(Small());
+    serverConnection->Send(Big(BigSize));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    AWE_CHECK(streamedSize == 0);
+    AWE_CHECK(!client.HasIncoming());
+    server.Flush();
+    AWE_CHECK(WaitFor([&]() { return streamedSize == BigSize; }));
+    AWE_CHECK(streamValid);
+    AWE_CHECK(client.HasIncoming());
+    auto small = client.Incoming().pop_front();
+    AWE_CHECK(small.second.Header.ID == static_cast<uint8_t>(PacketID::Small));
+    AWE_CHECK(!client.HasIncoming());
+
+    std::cout << "Fragmented packets OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,47 @@
+#include <AWEngine/Packet/Util/LatencyHistogram.hpp>
+
+#include "Check.hpp"
+#include <iostream>
+
+int main(int argc, const char** argv)
+{
+    using namespace AWEngine::Packet::Util;
+    using namespace std::chrono_literals;
+
+    // Every bucket covers the values it claims to
+    for(uint64_t us = 0; us < 1'000'000; us += 7)
+    {
+        uint32_t index = LatencyHistogram::BucketIndex(us);
+        AWE_CHECK(us <= LatencyHistogram::BucketUpperBound(index));
+        AWE_CHECK(index == 0 || us > LatencyHistogram::BucketUpperBound(index - 1));
+    }
+
+    // Percentiles are within the bucket precision
+    LatencyHistogram histogram;
+    AWE_CHECK(histogram.Percentile(0.5) == 0ns);
+    for(int i = 1; i <= 1000; i++)
+        histogram.Record(std::chrono::microseconds(i * 10));
+
+    AWE_CHECK(histogram.Count() == 1000);
+    auto p50 = histogram.Percentile(0.50);
+    auto p99 = histogram.Percentile(0.99);
+    std::cout << "p50: " << p50.count() << "ns, p99: " << p99.count() << "ns" << std::endl;
+    AWE_CHECK(p50 >= 5000us && p50 <= 5000us * 17 / 16);
+    AWE_CHECK(p99 >= 9900us && p99 <= 9900us * 17 / 16);
+
+    // Values outside of the range end in the last bucket
+    histogram.Record(1h);
+    AWE_CHECK(histogram.Percentile(1.0) == std::chrono::microseconds(LatencyHistogram::BucketUpperBound(LatencyHistogram::BucketCount - 1)));
+
+    // Smoothed RTT converges to stable samples
+    RttStats rtt;
+    rtt.Record(10ms);
+    AWE_CHECK(rtt.Smoothed() == 10ms);
+    for(int i = 0; i < 100; i++)
+        rtt.Record(2ms);
+    AWE_CHECK(rtt.Smoothed() < 2100us);
+    AWE_CHECK(rtt.Jitter() < 100us);
+    AWE_CHECK(rtt.Last() == 2ms);
+
+    return 0;
+}
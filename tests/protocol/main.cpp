@@ -0,0 +1,128 @@
+#include <AWEngine/Packet/Protocol.hpp>
+
+#include "Check.hpp"
+#include <iostream>
+
+using namespace AWEngine::Packet;
+
+struct Position : public IPacket<PacketID>
+{
+    static const constexpr PacketID s_ID = PacketID::Position;
+
+    explicit Position(float x, float y) : IPacket<PacketID>(s_ID), X(x), Y(y) {}
+    explicit Position(PacketBuffer& in) : IPacket<PacketID>(s_ID) { in >> X >> Y; }
+
+    float X;
+    float Y;
+
+    void Write(PacketBuffer& out) const override { out << X << Y; }
+};
+
+struct Chat : public IPacket<PacketID>
+{
+    static const constexpr PacketID s_ID = PacketID::Chat;
+
+    explicit Chat(std::string text) : IPacket<PacketID>(s_ID), Text(std::move(text)) {}
+    explicit Chat(PacketBuffer& in) : IPacket<PacketID>(s_ID) { in >> Text; }
+
+    std::string Text;
+
+    void Write(PacketBuffer& out) const override { out << Text; }
+};
+
+struct Jump : public IPacket<PacketID>
+{
+    static const constexpr PacketID s_ID = PacketID::Jump;
+
+    explicit Jump() : IPacket<PacketID>(s_ID) {}
+    explicit Jump(PacketBuffer& in) : IPacket<PacketID>(s_ID) {}
+
+    void Write(PacketBuffer& out) const override {}
+};
+
+typedef Protocol<PacketID, Position, Chat, Jump> Protocol_t;
+
+static_assert(Protocol_t::size() == 3);
+static_assert(Protocol_t::Contains(static_cast<uint8_t>(PacketID::Jump)));
+static_assert(!Protocol_t::Contains(3));
+static_assert(!Protocol_t::Contains(static_cast<uint8_t>(PacketID::Ping)));
+
+Util::PacketSendInfo Serialize(const IPacket<PacketID>& packet)
+{
+    Util::PacketSendInfo info = {};
+    info.Header.ID = static_cast<uint8_t>(packet.ID);
+    packet.Write(info.Body);
+    return info;
+}
+
+int main(int argc, const char** argv)
+{
+    // Usable as parser of the server
+    Util::PacketSendInfo chat = Serialize(Chat("Hello"));
+    Protocol_t::Packet_ptr parsed = Protocol_t::Parse(chat);
+    AWE_CHECK(parsed && parsed->ID == PacketID::Chat);
+    AWE_CHECK(dynamic_cast<Chat&>(*parsed).Text == "Hello");
+
+    Util::PacketSendInfo unknown = {};
+    unknown.Header.ID = 3;
+    AWE_CHECK(Protocol_t::Parse(unknown) == nullptr);
+
+    // Typed dispatch
+    int positions = 0;
+    int jumps     = 0;
+    auto handler = [&](auto& packet)
+    {
+        using T = std::remove_cvref_t<decltype(packet)>;
+        if constexpr(std::is_same_v<T, Position>)
+        {
+            AWE_CHECK(packet.X == 1.5f && packet.Y == -2.0f);
+            positions++;
+        }
+        else if constexpr(std::is_same_v<T, Jump>)
+        {
+            jumps++;
+        }
+    };
+
+    Util::PacketSendInfo position = Serialize(Position(1.5f, -2.0f));
+    AWE_CHECK(Protocol_t::Dispatch(position, handler));
+    Util::PacketSendInfo jump = Serialize(Jump());
+    AWE_CHECK(Protocol_t::Dispatch(jump, handler));
+    AWE_CHECK(!Protocol_t::Dispatch(unknown, handler));
+    AWE_CHECK(positions == 1 && jumps == 1);
+
+    // Arena parser, memory is reused after reset
+    {
+        Util::PacketArena arena(256);
+        Util::PacketSendInfo chat2 = Serialize(Chat("Arena"));
+        IPacket<PacketID>* inArena = Protocol_t::ParseInto(arena, chat2);
+        AWE_CHECK(inArena && dynamic_cast<Chat&>(*inArena).Text == "Arena");
+        AWE_CHECK(Protocol_t::ParseInto(arena, unknown) == nullptr);
+        AWE_CHECK(arena.ObjectCount() == 1);
+
+        std::size_t capacity = arena.Capacity();
+        arena.Reset();
+        AWE_CHECK(arena.ObjectCount() == 0);
+        Util::PacketSendInfo chat3 = Serialize(Chat("Again"));
+        AWE_CHECK(Protocol_t::ParseInto(arena, chat3) == inArena);
+        AWE_CHECK(arena.Capacity() == capacity);
+    }
+
+    // Static send path produces the same frame as the virtual one
+    {
+        typedef Util::Connection<PacketID, PacketID::Ping, PacketID::Init> Connection_t;
+        Position packet(3.0f, 4.0f);
+        Connection_t::Frame_ptr dynamic = Connection_t::MakeFrame(static_cast<const IPacket<PacketID>&>(packet));
+        Connection_t::Frame_ptr fixed   = Connection_t::MakeFrame(packet);
+        AWE_CHECK(dynamic->Body.Buffer() == fixed->Body.Buffer());
+        AWE_CHECK(fixed->Header.ID == static_cast<uint8_t>(PacketID::Position) && fixed->Header.Size == 2 * sizeof(float));
+    }
+
+    // Single packet parser
+    Util::PacketSendInfo jump2 = Serialize(Jump());
+    auto parser = AWE_PACKET_PARSER(Jump, PacketID);
+    AWE_CHECK(parser(jump2)->ID == PacketID::Jump);
+
+    std::cout << "Protocol OK" << std::endl;
+    return 0;
+}
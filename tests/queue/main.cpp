@@ -0,0 +1,84 @@
+#include <AWEngine/Packet/Util/ThreadSafeQueue.hpp>
+
+#include "Check.hpp"
+#include <iostream>
+#include <thread>
+
+int main(int argc, const char** argv)
+{
+    using namespace AWEngine::Packet::Util;
+
+    // Timed wait on empty queue returns after the timeout
+    {
+        ThreadSafeQueue<int> queue;
+        auto start = std::chrono::steady_clock::now();
+        AWE_CHECK(!queue.wait_for(std::chrono::milliseconds(20)));
+        AWE_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+        queue.push_back(1);
+        AWE_CHECK(queue.wait_for(std::chrono::seconds(0)));
+        AWE_CHECK(queue.wait_until(std::chrono::steady_clock::now() - std::chrono::seconds(1)));
+    }
+
+    // Ping-pong - every item is pushed right when the other thread goes to sleep, a missed wakeup would hang
+    {
+        static const int Rounds = 20'000;
+
+        ThreadSafeQueue<int> requests;
+        ThreadSafeQueue<int> responses;
+        std::thread echo(
+            [&]()
+            {
+                for(int i = 0; i < Rounds; i++)
+                {
+                    requests.wait();
+                    responses.push_back(requests.pop_front());
+                }
+            }
+        );
+
+        for(int i = 0; i < Rounds; i++)
+        {
+            requests.push_back(i);
+            bool received = responses.wait_for(std::chrono::seconds(10));
+            AWE_CHECK(received);
+            AWE_CHECK(responses.pop_front() == i);
+        }
+        echo.join();
+    }
+
+    // Shared signal wakes a thread waiting for any of the queues
+    {
+        QueueSignal signal;
+        ThreadSafeQueue<int> a;
+        ThreadSafeQueue<int> b;
+        a.set_signal(&signal);
+        b.set_signal(&signal);
+
+        uint32_t sequence = signal.Sequence();
+        AWE_CHECK(!signal.WaitUntil(sequence, std::chrono::steady_clock::now() + std::chrono::milliseconds(5)));
+
+        std::thread producer([&]() { b.push_back(2); });
+        while(a.empty() && b.empty())
+        {
+            sequence = signal.Sequence();
+            if(a.empty() && b.empty())
+                signal.WaitUntil(sequence, std::chrono::steady_clock::time_point::max());
+        }
+        producer.join();
+        AWE_CHECK(b.pop_front() == 2);
+
+        // Notified before waiting - returns right away
+        sequence = signal.Sequence();
+        a.push_back(1);
+        AWE_CHECK(signal.WaitUntil(sequence, std::chrono::steady_clock::time_point::max()));
+
+        // Only pushing into empty queue touches the shared signal
+        sequence = signal.Sequence();
+        a.push_back(3);
+        AWE_CHECK(signal.Sequence() == sequence);
+    }
+
+    std::cout << "Thread-safe queue OK" << std::endl;
+    return 0;
+}
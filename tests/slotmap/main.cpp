@@ -0,0 +1,69 @@
+#include <AWEngine/Packet/Util/SlotMap.hpp>
+
+#include "Check.hpp"
+#include <iostream>
+#include <string>
+#include <unordered_set>
+
+int main(int argc, const char** argv)
+{
+    using namespace AWEngine::Packet::Util;
+
+    SlotMap<std::string> map;
+    AWE_CHECK(map.empty());
+    AWE_CHECK(!map.Contains({}));
+
+    SlotMapKey a = map.Insert("a");
+    SlotMapKey b = map.Insert("b");
+    SlotMapKey c = map.Insert("c");
+    AWE_CHECK(map.size() == 3);
+    AWE_CHECK(*map.Find(a) == "a");
+    AWE_CHECK(*map.Find(b) == "b");
+    AWE_CHECK(*map.Find(c) == "c");
+
+    // Removing from the middle keeps other keys valid
+    AWE_CHECK(map.Erase(a));
+    AWE_CHECK(!map.Erase(a));
+    AWE_CHECK(map.Find(a) == nullptr);
+    AWE_CHECK(*map.Find(b) == "b");
+    AWE_CHECK(*map.Find(c) == "c");
+    AWE_CHECK(map.size() == 2);
+
+    // Reused slot does not resurrect the old key
+    SlotMapKey d = map.Insert("d");
+    AWE_CHECK(d.Index == a.Index);
+    AWE_CHECK(d != a);
+    AWE_CHECK(map.Find(a) == nullptr);
+    AWE_CHECK(*map.Find(d) == "d");
+
+    // Forged key of a free slot (generation the slot will have once reused) does not match
+    SlotMapKey e = map.Insert("e");
+    AWE_CHECK(map.Erase(e));
+    AWE_CHECK(!map.Contains({ e.Index, e.Generation + 1 }));
+    AWE_CHECK(map.Find({ e.Index, e.Generation + 1 }) == nullptr);
+    AWE_CHECK(!map.Erase({ e.Index, e.Generation + 1 }));
+    AWE_CHECK(map.Find({ e.Index + 1000, e.Generation }) == nullptr);
+    AWE_CHECK(map.size() == 3);
+
+    // Iteration visits every value once, keys match their values
+    std::unordered_set<std::string> seen;
+    for(std::size_t i = 0; i < map.size(); i++)
+        AWE_CHECK(*map.Find(map.KeyAt(i)) == *(map.begin() + i));
+    for(const std::string& value : map)
+        AWE_CHECK(seen.insert(value).second);
+    AWE_CHECK(seen == std::unordered_set<std::string>({ "b", "c", "d" }));
+
+    // Bulk removal
+    for(int i = 0; i < 100; i++)
+        map.Insert(std::to_string(i));
+    AWE_CHECK(map.EraseIf([](const std::string& value) { return value.size() == 1; }) == 13); // b, c, d, 0-9
+    AWE_CHECK(map.size() == 90);
+    AWE_CHECK(map.Find(b) == nullptr);
+
+    map.clear();
+    AWE_CHECK(map.empty());
+    AWE_CHECK(map.Find(d) == nullptr);
+
+    std::cout << "SlotMap OK" << std::endl;
+    return 0;
+}
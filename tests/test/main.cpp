@@ -1,23 +1,7 @@
 #include "AWEngine/Packet/PacketServer.hpp"
 #include "AWEngine/Packet/PacketClient.hpp"
 
-enum class PacketID : uint8_t
-{
-    MsgA = 0u,
-    MsgB = 1u,
-    MsgC = 2u,
-
-    //----------------
-
-    Ping       = 0xF0u,
-    Pong       = Ping, // Can be same because of packet direction
-
-    Init       = 0xF1u,
-    ServerInfo = Init, // Can be same because of packet direction
-
-    Kick       = 0xFFu,
-    Disconnect = Kick // Can be same because of packet direction
-};
+#include "Check.hpp"
 
 using namespace AWEngine;
 using namespace AWEngine::Packet;
@@ -49,16 +33,16 @@ int main()
 
     PacketServerConfiguration serverConfig;
     serverConfig.DisplayName = "Code Test Server";
-    serverConfig.MaxPlayers = 1;
+    serverConfig.MaxPlayers = 2;
 
     //typedef PacketServer<PacketID> PacketServer_t;
-    typedef PacketServer<PacketID, PacketID::Ping, PacketID::Kick, PacketID::ServerInfo> PacketServer_t;
+    typedef PacketServer<PacketID, PacketID> PacketServer_t;
 
     PacketServer_t server(
         serverConfig,
-        [](PacketServer_t::PacketInfo_t& info) -> PacketServer_t::Packet_ptr
+        [](Util::PacketSendInfo& info) -> PacketServer_t::Packet_ptr
         {
-            switch(info.Header.ID)
+            switch(static_cast<PacketID>(info.Header.ID))
             {
                 case PacketID::MsgA:
                     return std::make_unique<MsgA>();
@@ -69,6 +53,7 @@ int main()
                 case PacketID::Pong:
                     std::cout << "Received Pong" << std::endl;
                     return {}; // No need to respond, server does it automatically
+                case PacketID::Init: // Handshake is done by the server
                 case PacketID::Disconnect:
                     return {};
                 default:
@@ -87,7 +72,7 @@ int main()
     {
         std::cout << "Client " << client->RemoteEndpoint() << " disconnected" << std::endl;
     };
-    server.OnMessage = [&](const PacketServer_t::Connection_ptr& client, PacketServer_t::PacketInfo_t& info) -> void
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr& client, Util::PacketSendInfo& info) -> void
     {
         std::cout << "Message received from " << client->RemoteEndpoint() << ", Packet ID = " << int(info.Header.ID) << std::endl;
     };
@@ -101,7 +86,7 @@ int main()
 
 #pragma endregion
 
-    typedef PacketClient<PacketID, PacketID::Pong, PacketID::Disconnect, PacketID::Init> PacketClient_t;
+    typedef PacketClient<PacketID, PacketID> PacketClient_t;
     //typedef PacketClient<PacketID> PacketClient_t;
 
 #pragma region Client
@@ -0,0 +1,524 @@
+#include "AWEngine/Packet/PacketServer.hpp"
+#include "AWEngine/Packet/PacketClient.hpp"
+
+#include "Check.hpp"
+
+using namespace AWEngine::Packet;
+
+struct Number : public IPacket<PacketID>
+{
+    explicit Number(uint32_t value) : IPacket<PacketID>(PacketID::Number), Value(value) {}
+
+    uint32_t Value;
+
+    void Write(PacketBuffer& out) const override { out << Value; }
+};
+
+/// Increasing numbers from `First` filling a whole frame
+struct Chunk : public IPacket<PacketID>
+{
+    static const constexpr std::size_t Count = PacketBuffer::MaxSize / sizeof(uint32_t);
+
+    explicit Chunk(uint32_t first) : IPacket<PacketID>(PacketID::Number), First(first) {}
+
+    uint32_t First;
+
+    void Write(PacketBuffer& out) const override
+    {
+        for(std::size_t i = 0; i < Count; i++)
+            out << static_cast<uint32_t>(First + i);
+    }
+};
+
+/// Counts live instances, created in the arena of `Update`
+struct Tracked : public IPacket<PacketID>
+{
+    static inline std::atomic<int> Alive = 0;
+
+    Tracked() : IPacket<PacketID>(PacketID::Number) { Alive++; }
+    ~Tracked() override { Alive--; }
+
+    void Write(PacketBuffer& out) const override {}
+};
+
+typedef PacketServer<PacketID, PacketID> PacketServer_t;
+typedef PacketClient<PacketID, PacketID> PacketClient_t;
+
+static const std::size_t ClientCount      = 16;
+static const uint32_t    PacketsPerClient = 500;
+
+/// Every client sends increasing numbers, server echoes them back, both sides check the order
+void RunEcho(const PacketServerConfiguration& serverConfig)
+{
+    PacketServer_t server(serverConfig, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+
+    std::map<PacketServer_t::Connection_ptr, uint32_t> expected;
+    bool inOrder = true;
+    std::size_t received = 0;
+    std::mutex handlerMutex; // Handlers run in parallel with `DispatchThreadCount`
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr& client, Util::PacketSendInfo& info)
+    {
+        if(info.Header.ID != static_cast<uint8_t>(PacketID::Number))
+            return;
+
+        std::scoped_lock lock(handlerMutex);
+
+        uint32_t value;
+        info.Body >> value;
+        inOrder &= value == expected[client]++;
+        AWE_CHECK(server.Find(client->Id()) == client);
+        received++;
+
+        server.Send(client, Number(value));
+    };
+    server.Start();
+
+    std::vector<std::unique_ptr<PacketClient_t>> clients;
+    for(std::size_t i = 0; i < ClientCount; i++)
+    {
+        clients.emplace_back(std::make_unique<PacketClient_t>("AWE_TST", 0));
+        clients.back()->Connect("localhost", serverConfig.Port);
+    }
+    for(auto& client : clients)
+        client->WaitForConnect();
+
+    for(uint32_t value = 0; value < PacketsPerClient; value++)
+        for(auto& client : clients)
+            client->Send(Number(value));
+
+    // Limited updates leave the rest of the batch for the next one, order is kept
+    auto drain = [&]()
+    {
+        while(server.Update(64, false) == 64)
+        {
+        }
+        return received == ClientCount * PacketsPerClient;
+    };
+    AWE_CHECK(WaitFor(drain));
+    AWE_CHECK(inOrder);
+    AWE_CHECK(expected.size() == ClientCount);
+
+    // Echoes arrive in order too
+    for(auto& client : clients)
+    {
+        AWE_CHECK(WaitFor([&]() { return client->Incoming().size() >= PacketsPerClient; }));
+
+        uint32_t next = 0;
+        while(client->HasIncoming())
+        {
+            auto msg = client->Incoming().pop_front();
+            if(msg.second.Header.ID != static_cast<uint8_t>(PacketID::Number))
+                continue;
+
+            uint32_t value;
+            msg.second.Body >> value;
+            AWE_CHECK(value == next);
+            next++;
+        }
+        AWE_CHECK(next == PacketsPerClient);
+    }
+
+    // Fan-out to listed clients, stale handles are skipped
+    std::vector<Util::ConnectionId> ids;
+    for(auto& [connection, count] : expected)
+        ids.emplace_back(connection->Id());
+    ids.emplace_back(Util::ConnectionId{ 0, { 12345, 1 } });
+    AWE_CHECK(server.Send(ids, Number(PacketsPerClient)) == ClientCount);
+    for(auto& client : clients)
+    {
+        AWE_CHECK(WaitFor([&]() { return client->HasIncoming(); }));
+        auto msg = client->Incoming().pop_front();
+        uint32_t value;
+        msg.second.Body >> value;
+        AWE_CHECK(value == PacketsPerClient);
+    }
+
+    // Every client is counted exactly once
+    AWE_CHECK(server.TrafficSnapshot().PacketsIn == ClientCount * (PacketsPerClient + 1)); // + Init
+
+    // Channel with every second client
+    Util::ChannelId channel = server.CreateChannel();
+    std::vector<PacketServer_t::Connection_ptr> members;
+    for(auto& [connection, count] : expected)
+        if(members.size() < ClientCount / 2 && server.JoinChannel(channel, connection->Id()))
+            members.emplace_back(connection);
+    AWE_CHECK(!server.JoinChannel(channel, members.front()->Id()));
+    AWE_CHECK(!server.JoinChannel(channel, Util::ConnectionId{ 0, { 12345, 1 } }));
+    AWE_CHECK(server.ChannelSize(channel) == ClientCount / 2);
+    AWE_CHECK(server.SendToChannel(channel, Number(0)) == ClientCount / 2);
+    AWE_CHECK(WaitFor([&]() { return server.TrafficSnapshot().PacketsOut == ClientCount * (PacketsPerClient + 1) + ClientCount / 2; }));
+
+    // Disconnected members leave automatically
+    AWE_CHECK(server.LeaveChannel(channel, members[0]->Id()));
+    AWE_CHECK(!server.LeaveChannel(channel, members[0]->Id()));
+    members[1]->Disconnect();
+    AWE_CHECK(WaitFor([&]() { return !members[1]->IsConnected(); }));
+    server.SendKeepAlive();
+    AWE_CHECK(server.ChannelSize(channel) == ClientCount / 2 - 2);
+    AWE_CHECK(server.DestroyChannel(channel));
+    AWE_CHECK(server.ChannelSize(channel) == 0);
+    AWE_CHECK(server.SendToChannel(channel, Number(0)) == 0);
+}
+
+/// Quiet clients get pinged, clients which never send their intent get dropped.
+/// Pings do not wait for `Flush` of deferred mode.
+void RunTimeouts(uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port              = port;
+    config.KeepAliveInterval = std::chrono::milliseconds(20);
+    config.IdleTimeout       = std::chrono::seconds(5);
+    config.HandshakeTimeout  = std::chrono::milliseconds(200);
+    config.TimeoutResolution = std::chrono::milliseconds(10);
+    config.DeferredSend      = true;
+    config.AutoFlush         = false;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+
+    std::size_t disconnects = 0;
+    server.OnClientDisconnect = [&](const PacketServer_t::Connection_ptr&) { disconnects++; };
+    server.Start();
+
+    PacketClient_t client("AWE_TST", 0);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+
+    // Connects but never sends Init
+    asio::io_context rawContext;
+    asio::ip::tcp::socket raw(rawContext);
+    raw.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+
+    AWE_CHECK(WaitFor([&]() { server.Update(-1, false); return disconnects == 1; }));
+    AWE_CHECK(server.ConnectionCount() == 1);
+
+    // Client does not send anything on its own, only responds to KeepAlive
+    AWE_CHECK(WaitFor([&]() { return server.Latency(0).Count() >= 3; }));
+    server.Update(-1, false);
+    AWE_CHECK(disconnects == 1);
+    AWE_CHECK(server.ConnectionCount() == 1);
+}
+
+/// Send Init over a raw socket and read everything until the server closes the connection
+Util::PacketSendInfo RawHandshake(uint16_t port, ProtocolGameVersion version, ToServer::Login::NextInitStep next)
+{
+    asio::io_context rawContext;
+    asio::ip::tcp::socket raw(rawContext);
+    raw.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+
+    typedef Util::Connection<PacketID, PacketID::Ping, PacketID::Init> Connection_t;
+    Connection_t::Frame_ptr init = Connection_t::MakeFrame(ToServer::Login::Init<PacketID, PacketID::Init>("AWE_TST", version, Util::LocaleInfo(), next));
+    asio::write(raw, init->Body.Frame());
+
+    std::vector<uint8_t> response(1024);
+    asio::error_code ec;
+    std::size_t length = asio::read(raw, asio::buffer(response), ec);
+    AWE_CHECK(ec == asio::error::eof);
+    AWE_CHECK(length >= Util::PacketSendInfo::HeaderSize);
+
+    Util::PacketSendInfo info = {};
+    info.Body.ReservePrefix(Util::PacketSendInfo::HeaderSize);
+    std::copy(response.begin(), response.begin() + Util::PacketSendInfo::HeaderSize, info.Body.Prefix());
+    info.ParseHeader();
+    AWE_CHECK(length == Util::PacketSendInfo::HeaderSize + info.Header.Size);
+    info.Body.Write(info.Header.Size, response.data() + Util::PacketSendInfo::HeaderSize);
+    return info;
+}
+
+/// Clients joining over `MaxPlayers` get Kick, a full server still answers status requests.
+/// Sockets over `MaxConnections` get Kick before anything is created for them.
+void RunAdmission(uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port           = port;
+    config.MaxPlayers     = 2;
+    config.MaxConnections = 3;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+    std::size_t connects = 0;
+    server.OnClientConnect = [&](const PacketServer_t::Connection_ptr&) { connects++; return true; };
+    server.Start();
+
+    PacketClient_t first("AWE_TST", 0);
+    first.Connect("localhost", port);
+    first.WaitForConnect();
+    PacketClient_t second("AWE_TST", 0);
+    second.Connect("localhost", port);
+    second.WaitForConnect();
+    AWE_CHECK(WaitFor([&]() { return server.PlayerCount() == 2; }));
+
+    Util::PacketSendInfo kick = RawHandshake(port, 0, ToServer::Login::NextInitStep::Join);
+    AWE_CHECK(kick.Header.ID == static_cast<uint8_t>(PacketID::Kick));
+    AWE_CHECK(server.TrafficSnapshot().Rejected == 1);
+
+    // Remove the kicked socket so the status request fits under `MaxConnections`
+    server.SendKeepAlive();
+    AWE_CHECK(WaitFor([&]() { return server.ConnectionCount() == 2; }));
+    Util::PacketSendInfo status = RawHandshake(port, 0, ToServer::Login::NextInitStep::ServerInfo);
+    AWE_CHECK(status.Header.ID == static_cast<uint8_t>(PacketID::ServerInfo));
+    AWE_CHECK(server.PlayerCount() == 2);
+    AWE_CHECK(WaitFor([&]() { return server.ConnectionCount() == 2; }));
+
+    // Third socket never sends Init, the fourth is over the limit
+    asio::io_context rawContext;
+    asio::ip::tcp::socket idle(rawContext);
+    idle.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+    AWE_CHECK(WaitFor([&]() { return server.ConnectionCount() == 3; }));
+    asio::ip::tcp::socket raw(rawContext);
+    raw.connect(asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), port));
+    std::vector<uint8_t> response(64);
+    asio::error_code ec;
+    std::size_t length = asio::read(raw, asio::buffer(response), ec);
+    AWE_CHECK(ec == asio::error::eof);
+    AWE_CHECK(length > Util::PacketSendInfo::HeaderSize && response[0] == 0xFFu);
+
+    AWE_CHECK(server.TrafficSnapshot().Rejected == 2);
+    AWE_CHECK(server.ConnectionCount() == 3);
+    AWE_CHECK(connects == 5);
+}
+
+/// Status requests are answered by network threads, incompatible clients are kicked, neither reaches the game
+void RunHandshake(uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port = port;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 3);
+    std::size_t messages    = 0;
+    std::size_t disconnects = 0;
+    server.OnMessage          = [&](const PacketServer_t::Connection_ptr&, Util::PacketSendInfo&) { messages++; };
+    server.OnClientDisconnect = [&](const PacketServer_t::Connection_ptr&) { disconnects++; };
+    server.SetServerInfo("{\"name\": \"Test\"}");
+    server.Start();
+
+    Util::PacketSendInfo status = RawHandshake(port, 0, ToServer::Login::NextInitStep::ServerInfo);
+    AWE_CHECK(status.Header.ID == static_cast<uint8_t>(PacketID::ServerInfo));
+    ToClient::Login::ServerInfo<PacketID, PacketID::ServerInfo> info(status.Body);
+    AWE_CHECK(info.JsonString == "{\"name\": \"Test\"}" && info.GameVersion == 3);
+    AWE_CHECK(WaitFor([&]() { return server.ConnectionCount() == 0; }));
+
+    // Wrong version of the game
+    Util::PacketSendInfo kick = RawHandshake(port, 2, ToServer::Login::NextInitStep::Join);
+    AWE_CHECK(kick.Header.ID == static_cast<uint8_t>(PacketID::Kick));
+
+    server.Update(-1, false);
+    AWE_CHECK(messages == 0);
+    AWE_CHECK(disconnects == 0);
+}
+
+/// `Update(budget)` leaves the rest for the next one, `WaitFor` wakes on message or timeout
+void RunBudget(uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port = port;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+
+    std::size_t received = 0;
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr&, Util::PacketSendInfo&)
+    {
+        // Slow handler
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        received++;
+    };
+    server.Start();
+
+    // Nothing to wait for
+    auto start = std::chrono::steady_clock::now();
+    AWE_CHECK(!server.WaitFor(std::chrono::milliseconds(20)));
+    AWE_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    PacketClient_t client("AWE_TST", 0);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+    AWE_CHECK(server.WaitFor(std::chrono::seconds(5))); // Init
+
+    for(uint32_t value = 0; value < 100; value++)
+        client.Send(Number(value));
+    AWE_CHECK(WaitFor([&]() { return server.TrafficSnapshot().PacketsIn == 101; })); // + Init
+
+    // One batch takes longer than the budget
+    std::size_t processed = server.Update(std::chrono::milliseconds(5));
+    AWE_CHECK(processed == PacketServer_t::UpdateBudgetBatch);
+    AWE_CHECK(received == processed);
+
+    while(server.Update(std::chrono::milliseconds(5)) != 0)
+    {
+    }
+    AWE_CHECK(received == 101);
+    AWE_CHECK(!server.WaitFor(std::chrono::milliseconds(0)));
+}
+
+/// Reading pauses at `MaxPendingPacketsPerClient` and resumes once `Update` processes the packets
+void RunBackpressure(uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port                       = port;
+    config.MaxPendingPacketsPerClient = 8;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+    std::size_t received = 0;
+    server.OnMessage = [&](const PacketServer_t::Connection_ptr&, Util::PacketSendInfo&) { received++; };
+    server.Start();
+
+    PacketClient_t client("AWE_TST", 0);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+    for(uint32_t value = 0; value < 100; value++)
+        client.Send(Number(value));
+
+    AWE_CHECK(WaitFor([&]() { return server.TrafficSnapshot().ReadsPaused != 0; }));
+    AWE_CHECK(server.TrafficSnapshot().PacketsIn == 8); // Init + 7
+
+    AWE_CHECK(WaitFor([&]() { server.Update(-1, false); return received == 101; }));
+    AWE_CHECK(server.TrafficSnapshot().PendingInHighWater == 8);
+}
+
+/// Exception of a handler leaves `Update`, packets parsed for it are destroyed anyway
+void RunThrowingHandler(uint16_t port)
+{
+    PacketServerConfiguration config;
+    config.Port = port;
+    config.DispatchThreadCount = 2;
+    PacketServer_t server(config, [](Util::PacketArena& arena, Util::PacketSendInfo&) -> IPacket<PacketID>* { return arena.Create<Tracked>(); }, "AWE_TST", 0);
+
+    std::atomic<std::size_t> handled = 0;
+    server.OnArenaPacket = [&](const PacketServer_t::Connection_ptr&, IPacket<PacketID>&)
+    {
+        handled++;
+        throw std::runtime_error("Handler failed");
+    };
+    server.Start();
+
+    PacketClient_t client("AWE_TST", 0);
+    client.Connect("localhost", port);
+    client.WaitForConnect();
+    for(uint32_t value = 0; value < 10; value++)
+        client.Send(Number(value));
+    AWE_CHECK(WaitFor([&]() { return server.TrafficSnapshot().PacketsIn == 11; })); // + Init
+
+    bool thrown = false;
+    try
+    {
+        server.Update(-1, false);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    AWE_CHECK(thrown);
+    AWE_CHECK(handled > 0);
+    AWE_CHECK(Tracked::Alive == 0);
+
+    // Next `Update` works as usual
+    server.OnArenaPacket = [&](const PacketServer_t::Connection_ptr&, IPacket<PacketID>&) { handled++; };
+    client.Send(Number(10));
+    AWE_CHECK(WaitFor([&]() { server.Update(-1, false); return Tracked::Alive == 0 && server.TrafficSnapshot().PacketsIn == 12; }));
+    server.Update(-1, false);
+    AWE_CHECK(Tracked::Alive == 0);
+}
+
+/// Big frames shared by all clients are sent without copying, interleaved small ones the usual way
+void RunZeroCopy(uint16_t port)
+{
+    static const std::size_t ZeroCopyClients = 4;
+    static const uint32_t    ChunkCount      = 50;
+
+    PacketServerConfiguration config;
+    config.Port = port;
+    config.MaxPlayers = ZeroCopyClients;
+    config.ZeroCopyThreshold = 16 * 1024;
+    PacketServer_t server(config, [](Util::PacketSendInfo&) -> PacketServer_t::Packet_Receive_ptr { return {}; }, "AWE_TST", 0);
+    server.Start();
+
+    std::vector<std::unique_ptr<PacketClient_t>> clients;
+    for(std::size_t i = 0; i < ZeroCopyClients; i++)
+    {
+        clients.emplace_back(std::make_unique<PacketClient_t>("AWE_TST", 0));
+        clients.back()->Connect("localhost", port);
+    }
+    for(auto& client : clients)
+        client->WaitForConnect();
+    AWE_CHECK(WaitFor([&]() { return server.TrafficSnapshot().PacketsIn == ZeroCopyClients; })); // Init
+
+    // Every chunk is a different frame released only after the kernel is done with it
+    for(uint32_t i = 0; i < ChunkCount; i++)
+    {
+        server.Send_AllClients(Number(i));
+        server.Send_AllClients(Chunk(i));
+    }
+
+    for(auto& client : clients)
+    {
+        AWE_CHECK(WaitFor([&]() { return client->Incoming().size() >= 2 * ChunkCount; }));
+
+        uint32_t next = 0;
+        while(client->HasIncoming())
+        {
+            auto msg = client->Incoming().pop_front();
+            if(msg.second.Header.ID != static_cast<uint8_t>(PacketID::Number))
+                continue;
+
+            bool isChunk = msg.second.Body.size() == Chunk::Count * sizeof(uint32_t);
+            AWE_CHECK(isChunk || msg.second.Body.size() == sizeof(uint32_t));
+
+            uint32_t value;
+            msg.second.Body >> value;
+            AWE_CHECK(value == next);
+            if(!isChunk)
+                continue;
+
+            for(std::size_t j = 1; j < Chunk::Count; j++)
+            {
+                msg.second.Body >> value;
+                AWE_CHECK(value == next + j);
+            }
+            next++;
+        }
+        AWE_CHECK(next == ChunkCount);
+    }
+
+    Util::TrafficStatsSnapshot stats = server.TrafficSnapshot();
+    AWE_CHECK(stats.PacketsOut == 2 * ChunkCount * ZeroCopyClients);
+    if(Util::ZeroCopySupported)
+        AWE_CHECK(stats.ZeroCopySends == ChunkCount * ZeroCopyClients);
+    else
+        AWE_CHECK(stats.ZeroCopySends == 0);
+}
+
+int main(int argc, const char** argv)
+{
+    // Thread pool running single context
+    PacketServerConfiguration poolConfig;
+    poolConfig.Port = 10131;
+    poolConfig.IoThreadCount = 4;
+    poolConfig.MaxPlayers = ClientCount;
+    RunEcho(poolConfig);
+
+    // Independent shards
+    PacketServerConfiguration shardConfig;
+    shardConfig.Port = 10132;
+    shardConfig.ShardCount = 4;
+    shardConfig.MaxPlayers = ClientCount;
+    RunEcho(shardConfig);
+
+    // Parallel dispatch
+    PacketServerConfiguration dispatchConfig;
+    dispatchConfig.Port = 10134;
+    dispatchConfig.DispatchThreadCount = 3;
+    dispatchConfig.MaxPlayers = ClientCount;
+    RunEcho(dispatchConfig);
+
+    // Half of the clients read through receive buffers
+    PacketServerConfiguration bufferConfig;
+    bufferConfig.Port = 10138;
+    bufferConfig.IoThreadCount = 2;
+    bufferConfig.MaxPlayers = ClientCount;
+    bufferConfig.ReceiveBuffers = ClientCount / 2;
+    RunEcho(bufferConfig);
+
+    RunTimeouts(10133);
+    RunAdmission(10135);
+    RunHandshake(10136);
+    RunBudget(10137);
+    RunZeroCopy(10139);
+    RunThrowingHandler(10142);
+    RunBackpressure(10143);
+
+    std::cout << "Multi-threaded server OK" << std::endl;
+    return 0;
+}
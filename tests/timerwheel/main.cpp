@@ -0,0 +1,59 @@
+#include <AWEngine/Packet/Util/TimerWheel.hpp>
+
+#include "Check.hpp"
+#include <iostream>
+#include <random>
+#include <vector>
+
+int main(int argc, const char** argv)
+{
+    using namespace AWEngine::Packet::Util;
+
+    TimerWheel<uint64_t> wheel;
+    AWE_CHECK(wheel.empty());
+
+    // Every timer expires exactly on its deadline, across all levels
+    std::mt19937_64 random(42);
+    std::vector<uint64_t> deadlines;
+    for(int i = 0; i < 10000; i++)
+        deadlines.emplace_back(1 + random() % (uint64_t(1) << (6 * 3 + 2)));
+    deadlines.emplace_back(64);
+    deadlines.emplace_back(4096);
+    deadlines.emplace_back(262144);
+    for(uint64_t deadline : deadlines)
+        wheel.Schedule(deadline, deadline);
+    AWE_CHECK(wheel.size() == deadlines.size());
+
+    std::size_t expired = 0;
+    for(uint64_t tick = 1; !wheel.empty(); tick++)
+    {
+        expired += wheel.Advance(tick, [&](uint64_t deadline) { AWE_CHECK(deadline == tick); });
+        AWE_CHECK(wheel.Now() == tick);
+    }
+    AWE_CHECK(expired == deadlines.size());
+
+    // Past deadlines expire on the next tick, timers can be scheduled from the callback
+    wheel.Schedule(0, 1);
+    std::size_t fired = 0;
+    auto reschedule = [&](uint64_t count)
+    {
+        if(count < 3)
+            wheel.Schedule(wheel.Now() + 1000, count + 1);
+        fired++;
+    };
+    AWE_CHECK(wheel.Advance(wheel.Now() + 1, reschedule) == 1);
+    AWE_CHECK(wheel.size() == 1);
+    AWE_CHECK(wheel.Advance(wheel.Now() + 999, reschedule) == 0);
+    AWE_CHECK(wheel.Advance(wheel.Now() + 1, reschedule) == 1);
+    AWE_CHECK(wheel.Advance(wheel.Now() + 1000, reschedule) == 1);
+    AWE_CHECK(fired == 3);
+    AWE_CHECK(wheel.empty());
+
+    // Beyond the last level
+    wheel.Schedule(wheel.Now() + TimerWheel<uint64_t>::MaxDelay + 100, 0);
+    AWE_CHECK(wheel.Advance(wheel.Now() + TimerWheel<uint64_t>::MaxDelay, [](uint64_t) {}) == 0);
+    AWE_CHECK(wheel.Advance(wheel.Now() + 100, [](uint64_t) {}) == 1);
+
+    std::cout << "TimerWheel OK" << std::endl;
+    return 0;
+}